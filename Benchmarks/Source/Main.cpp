@@ -0,0 +1,479 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 9:41:07pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/ControlRateFilter.h"
+#include "../../Source/FormantFilter.h"
+#include "../../Source/DistortionChain.h"
+#include "../../Source/Wavetable.h"
+#include "../../Source/OSCHandling.h"
+
+/**
+ Times the plugin's DSP classes the way processBlock drives them: mono blocks of a
+ bass-like input at 48 kHz. Each case prints the cost per sample and the share of
+ one core it would take in real time, so runs on the Pi and on a desktop compare
+ directly. Build the Release configuration; Debug numbers mean nothing.
+ */
+namespace
+{
+    constexpr double sampleRate  = 48000.0;
+    constexpr int    blockSize   = 128;
+    constexpr int    numBlocks   = 10000;   // ~27 s of audio per case
+    constexpr int    inputBlocks = 64;      // The input loops every 64 blocks
+
+    // Read back at the end so the optimiser can't drop work nobody looks at
+    float sink = 0.0f;
+
+    /// Low E with its first few harmonics and a little noise, roughly what the pickups give the ADC
+    juce::AudioBuffer<float> makeInput()
+    {
+        juce::AudioBuffer<float> input ( 1, blockSize * inputBlocks );
+        juce::Random             random ( 1 );
+
+        auto* data = input.getWritePointer ( 0 );
+
+        for (int sample = 0; sample < input.getNumSamples(); sample++)
+        {
+            double theta = juce::MathConstants<double>::twoPi * 41.2 * sample / sampleRate;
+
+            data[sample] = static_cast<float>( 0.5 * std::sin ( theta ) + 0.2 * std::sin ( 2.0 * theta ) + 0.1 * std::sin ( 3.0 * theta ) )
+                         + ( random.nextFloat() - 0.5f ) * 0.01f;
+        }
+
+        return input;
+    }
+
+    /// Prints one result line, with an optional note (such as an accuracy figure) after it
+    void printResult(const juce::String& name, double value, const juce::String& unit, double realTimePercent = -1.0,
+                     const juce::String& note = {})
+    {
+        std::cout << "  " << name.paddedRight ( ' ', 46 ) << juce::String ( value, 2 ).paddedLeft ( ' ', 9 ) << " " << unit;
+
+        if (realTimePercent >= 0.0)
+            std::cout << juce::String ( realTimePercent, 3 ).paddedLeft ( ' ', 9 ) << " % of real time";
+
+        if (note.isNotEmpty())
+            std::cout << "   " << note;
+
+        std::cout << std::endl;
+    }
+
+    /// Runs process( ) over numBlocks blocks of input (after a warm-up) and prints the time it took
+    template <typename Process>
+    void runCase(const juce::String& name, const juce::AudioBuffer<float>& input, Process&& process, const juce::String& note = {})
+    {
+        juce::AudioBuffer<float> block ( 1, blockSize );
+
+        auto run = [&] (int count)
+        {
+            for (int b = 0; b < count; b++)
+            {
+                block.copyFrom ( 0, 0, input, 0, ( b % inputBlocks ) * blockSize, blockSize );
+                process ( block );
+                sink += block.getSample ( 0, blockSize - 1 );
+            }
+        };
+
+        // Tables built, caches warm, smoothers settled
+        run ( numBlocks / 10 );
+
+        auto   start   = juce::Time::getHighResolutionTicks();
+        run ( numBlocks );
+        double seconds = juce::Time::highResolutionTicksToSeconds ( juce::Time::getHighResolutionTicks() - start );
+
+        double numSamples = static_cast<double>( numBlocks ) * blockSize;
+
+        printResult ( name, seconds * 1.0e9 / numSamples, "ns/sample", 100.0 * seconds * sampleRate / numSamples, note );
+    }
+
+    /// Triangle sweep between 100 Hz and 4 kHz, once a second: cheap enough not to swamp the filters
+    float sweepCutoff(double& phase)
+    {
+        phase += 1.0 / sampleRate;
+
+        if (phase >= 1.0)
+            phase -= 1.0;
+
+        return static_cast<float>( 100.0 + 7800.0 * std::abs ( phase - 0.5 ) );
+    }
+
+    /// Converts an amplitude to dB, floored so a perfect match prints a number rather than -inf
+    double toDecibels(double amplitude)
+    {
+        return 20.0 * std::log10 ( juce::jmax ( amplitude, 1.0e-9 ) );
+    }
+
+    /// Difference between a filter's output and the per-sample reference's over the same input
+    struct OutputError
+    {
+        double rmsDb;    // RMS of the difference, relative to the reference's RMS
+        double peakDb;   // Largest single-sample difference, dBFS
+
+        juce::String toString() const
+        {
+            return "error RMS " + juce::String ( rmsDb, 1 ) + " dB, peak " + juce::String ( peakDb, 1 ) + " dBFS";
+        }
+    };
+
+    /**
+     Runs a ControlRateFilter updated every interval samples and a per-sample
+     StateVariableTPTFilter side by side over two full cutoff sweeps of the looped
+     input, and measures how far apart their outputs end up.
+     */
+    OutputError measureFilterError(const juce::AudioBuffer<float>& input, int interval)
+    {
+        juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>( blockSize ), 1 };
+
+        juce::dsp::StateVariableTPTFilter<float> reference;
+        reference.prepare      ( spec );
+        reference.setResonance ( 2.0f );
+
+        ControlRateFilter filter;
+        filter.prepare            ( spec );
+        filter.setControlInterval ( interval );
+
+        const auto* data       = input.getReadPointer ( 0 );
+        const int   numSamples = static_cast<int>( 2.0 * sampleRate );
+
+        double phase            = 0.0;
+        double errorSquares     = 0.0;
+        double referenceSquares = 0.0;
+        double peakError        = 0.0;
+
+        for (int sample = 0; sample < numSamples; sample++)
+        {
+            float in     = data[sample % input.getNumSamples()];
+            float cutoff = sweepCutoff ( phase );
+
+            reference.setCutoffFrequency ( cutoff );
+
+            if (filter.isUpdateDue())
+                filter.setTargets ( cutoff, 2.0f );
+
+            double expected = reference.processSample ( 0, in );
+            double error    = filter.processSample ( in ) - expected;
+
+            errorSquares     += error * error;
+            referenceSquares += expected * expected;
+            peakError         = juce::jmax ( peakError, std::abs ( error ) );
+        }
+
+        return { toDecibels ( std::sqrt ( errorSquares / juce::jmax ( referenceSquares, 1.0e-18 ) ) ), toDecibels ( peakError ) };
+    }
+
+    //==============================================================================
+    void benchmarkFilters(const juce::AudioBuffer<float>& input)
+    {
+        std::cout << "\nState variable filter, cutoff swept every sample" << std::endl;
+
+        juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>( blockSize ), 1 };
+
+        {
+            juce::dsp::StateVariableTPTFilter<float> filter;
+            filter.prepare      ( spec );
+            filter.setResonance ( 2.0f );
+
+            double phase = 0.0;
+
+            runCase ( "juce::dsp::StateVariableTPTFilter", input, [&] (juce::AudioBuffer<float>& block)
+            {
+                auto* data = block.getWritePointer ( 0 );
+
+                for (int sample = 0; sample < blockSize; sample++)
+                {
+                    filter.setCutoffFrequency ( sweepCutoff ( phase ) );
+                    data[sample] = filter.processSample ( 0, data[sample] );
+                }
+            }, "(reference)" );
+        }
+
+        for (int interval : { 1, 16, 64 })
+        {
+            ControlRateFilter filter;
+            filter.prepare            ( spec );
+            filter.setControlInterval ( interval );
+
+            double phase = 0.0;
+
+            runCase ( "ControlRateFilter, update every " + juce::String ( interval ), input, [&] (juce::AudioBuffer<float>& block)
+            {
+                auto* data = block.getWritePointer ( 0 );
+
+                for (int sample = 0; sample < blockSize; sample++)
+                {
+                    float cutoff = sweepCutoff ( phase );
+
+                    if (filter.isUpdateDue())
+                        filter.setTargets ( cutoff, 2.0f );
+
+                    data[sample] = filter.processSample ( data[sample] );
+                }
+            }, measureFilterError ( input, interval ).toString() );
+        }
+
+        for (int interval : { 1, 16 })
+        {
+            FormantFilter formant;
+            formant.prepare            ( spec );
+            formant.setControlInterval ( interval );
+
+            float morph = 0.0f;
+
+            runCase ( "FormantFilter, morph swept, update every " + juce::String ( interval ), input, [&] (juce::AudioBuffer<float>& block)
+            {
+                morph = std::fmod ( morph + 0.01f, 9.0f );
+                formant.processBuffer ( block, morph, 1.0f );
+            } );
+        }
+    }
+
+    //==============================================================================
+    /**
+     Renders sines at about 2, 3.5 and 5 kHz through a DistortionChain and returns the
+     energy between the harmonics relative to the energy on them (and DC), in dB: what
+     folded back past Nyquist. Each tone sits on an odd FFT bin, so its aliases miss
+     its harmonics, and the Blackman-Harris window keeps leakage ~90 dB down.
+     */
+    double measureAliasing(const juce::dsp::ProcessSpec& spec, int oversampling, int quality)
+    {
+        constexpr int fftOrder  = 14;
+        constexpr int fftSize   = 1 << fftOrder;
+        constexpr int guardBins = 4;                  // Half the window's main lobe
+        constexpr int warmUp    = 16 * blockSize;     // Smoothers settled, oversampler filters full
+
+        juce::dsp::FFT                      fft    ( fftOrder );
+        juce::dsp::WindowingFunction<float> window ( fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris, false );
+
+        std::vector<float>       spectrum ( 2 * fftSize );
+        juce::AudioBuffer<float> block    ( 1, blockSize );
+
+        double harmonicEnergy = 0.0;
+        double aliasEnergy    = 0.0;
+
+        for (double frequency : { 2000.0, 3500.0, 5000.0 })
+        {
+            int    toneBin = static_cast<int>( frequency * fftSize / sampleRate ) | 1;
+            double omega   = juce::MathConstants<double>::twoPi * toneBin / fftSize;
+
+            DistortionChain chain;
+            chain.prepare         ( spec );
+            chain.setOversampling ( oversampling );
+            chain.setAntiAliasing ( quality, quality );
+
+            for (int start = 0; start < warmUp + fftSize; start += blockSize)
+            {
+                auto* data = block.getWritePointer ( 0 );
+
+                for (int sample = 0; sample < blockSize; sample++)
+                    data[sample] = static_cast<float>( 0.5 * std::sin ( omega * ( start + sample ) ) );
+
+                chain.processBuffer ( block, 20.0f, 1.0f, 8.0f, 1.0f, 0.005f, 0.0f );
+
+                if (start >= warmUp)
+                    std::copy ( data, data + blockSize, spectrum.begin() + ( start - warmUp ) );
+            }
+
+            window.multiplyWithWindowingTable       ( spectrum.data(), fftSize );
+            fft.performFrequencyOnlyForwardTransform ( spectrum.data() );
+
+            for (int bin = 0; bin < fftSize / 2; bin++)
+            {
+                double energy  = static_cast<double>( spectrum[bin] ) * spectrum[bin];
+                int    nearest = juce::roundToInt ( static_cast<double>( bin ) / toneBin ) * toneBin;
+
+                if (std::abs ( bin - nearest ) <= guardBins)
+                    harmonicEnergy += energy;
+                else
+                    aliasEnergy    += energy;
+            }
+        }
+
+        return toDecibels ( std::sqrt ( aliasEnergy / juce::jmax ( harmonicEnergy, 1.0e-18 ) ) );
+    }
+
+    void benchmarkDistortion(const juce::AudioBuffer<float>& input)
+    {
+        std::cout << "\nWaveshaper + foldback, fully wet" << std::endl;
+
+        juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>( blockSize ), 1 };
+
+        struct Setting { const char* name; int oversampling; int quality; };
+
+        const Setting settings[] =
+        {
+            { "Plain",                 0, 0 },
+            { "First-order ADAA",      0, 1 },
+            { "Plain, 2x oversampled", 1, 0 },
+            { "Plain, 4x oversampled", 2, 0 }
+        };
+
+        for (const auto& setting : settings)
+        {
+            DistortionChain chain;
+            chain.prepare         ( spec );
+            chain.setOversampling ( setting.oversampling );
+            chain.setAntiAliasing ( setting.quality, setting.quality );
+
+            auto aliasing = measureAliasing ( spec, setting.oversampling, setting.quality );
+
+            runCase ( setting.name, input, [&] (juce::AudioBuffer<float>& block)
+            {
+                chain.processBuffer ( block, 20.0f, 1.0f, 8.0f, 1.0f, 0.005f, 0.0f );
+            }, "aliasing " + juce::String ( aliasing, 1 ) + " dB" );
+        }
+
+        std::cout << "\nFoldback sine at 200x drive" << std::endl;
+
+        constexpr float drive = 200.0f;
+
+        runCase ( "std::sin( )", input, [&] (juce::AudioBuffer<float>& block)
+        {
+            auto* data = block.getWritePointer ( 0 );
+
+            for (int sample = 0; sample < blockSize; sample++)
+                data[sample] = std::sin ( data[sample] * drive );
+        } );
+
+        // Worst difference from a double precision sin over the same input
+        double maxError = 0.0;
+
+        for (int sample = 0; sample < input.getNumSamples(); sample++)
+        {
+            float x  = input.getSample ( 0, sample ) * drive;
+            maxError = juce::jmax ( maxError, std::abs ( FoldKernel::sinFold ( x ) - std::sin ( static_cast<double>( x ) ) ) );
+        }
+
+        runCase ( "FoldKernel::sinFold( )", input, [&] (juce::AudioBuffer<float>& block)
+        {
+            auto* data = block.getWritePointer ( 0 );
+
+            for (int sample = 0; sample < blockSize; sample++)
+                data[sample] = FoldKernel::sinFold ( data[sample] * drive );
+        }, "max error " + juce::String ( maxError, 8 ) );
+    }
+
+    //==============================================================================
+    void benchmarkBitCrusher(const juce::AudioBuffer<float>& input)
+    {
+        std::cout << "\nBitcrusher sample and hold, fully wet" << std::endl;
+
+        juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>( blockSize ), 1 };
+
+        for (int quality : { 0, 1 })
+        {
+            DistortionChain chain;
+            chain.prepare              ( spec );
+            chain.setCrushAntiAliasing ( quality );
+
+            runCase ( quality == 0 ? "Hard hold" : "PolyBLEP hold", input, [&] (juce::AudioBuffer<float>& block)
+            {
+                chain.processBuffer ( block, 1.0f, 0.0f, 1.0f, 0.0f, 0.005f, 1.0f );
+            } );
+        }
+    }
+
+    //==============================================================================
+    void benchmarkWavetable(const juce::AudioBuffer<float>& input)
+    {
+        std::cout << "\nSaw wavetable at 110 Hz" << std::endl;
+
+        SawWavetable saw;
+        saw.setSampleRate     ( static_cast<float>( sampleRate ) );
+        saw.populateWavetable ();
+        saw.setIncrement      ( 110.0f );
+
+        runCase ( "process( ) per sample", input, [&] (juce::AudioBuffer<float>& block)
+        {
+            auto* data = block.getWritePointer ( 0 );
+
+            for (int sample = 0; sample < blockSize; sample++)
+                data[sample] = saw.process();
+        } );
+
+        runCase ( "processBlock( )", input, [&] (juce::AudioBuffer<float>& block)
+        {
+            saw.processBlock ( block.getWritePointer ( 0 ), blockSize );
+        } );
+    }
+
+    //==============================================================================
+    void benchmarkOSCDispatch()
+    {
+        std::cout << "\nOSC address dispatch, one lookup per message" << std::endl;
+
+        // What the sketch sends
+        const char* const slotAddresses[OSCHandler::numSlots] =
+        {
+            "/juce/accelX", "/juce/accelY", "/juce/accelZ", "/juce/gyroX", "/juce/gyroY", "/juce/gyroZ",
+            "/juce/dist", "/juce/touchX", "/juce/touchY", "/juce/touchZ",
+            "/juce/accelXOnOff", "/juce/accelYOnOff", "/juce/accelZOnOff",
+            "/juce/gyroXOnOff", "/juce/gyroYOnOff", "/juce/gyroZOnOff",
+            "/juce/touchScreenXOnOff", "/juce/touchScreenYOnOff", "/juce/touchScreenZOnOff",
+            "/juce/distanceOnOff", "/juce/filtType", "/juce/filtPole",
+            "/juce/encoder1", "/juce/encoder2", "/juce/encButton1", "/juce/encButton2"
+        };
+
+        // Incoming message addresses, plus one that isn't ours
+        juce::StringArray addresses ( slotAddresses, OSCHandler::numSlots );
+        addresses.add ( "/juce/unknown" );
+
+        constexpr int numLookups = 2000000;
+
+        auto timeLookups = [&] (const juce::String& name, auto&& lookup)
+        {
+            int found = 0;
+
+            auto start = juce::Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numLookups; i++)
+                found += lookup ( addresses.getReference ( i % addresses.size() ) );
+
+            double seconds = juce::Time::highResolutionTicksToSeconds ( juce::Time::getHighResolutionTicks() - start );
+
+            sink += static_cast<float>( found );
+
+            printResult ( name, seconds * 1.0e9 / numLookups, "ns/message" );
+        };
+
+        // What the handler did before: compare against each address in turn
+        timeLookups ( "Linear string compare", [&] (const juce::String& address)
+        {
+            for (int slot = 0; slot < OSCHandler::numSlots; slot++)
+                if (address == slotAddresses[slot])
+                    return slot;
+
+            return -1;
+        } );
+
+        timeLookups ( "OSCHandler::findSlot( )", [] (const juce::String& address)
+        {
+            return OSCHandler::findSlot ( address );
+        } );
+    }
+}
+
+//==============================================================================
+int main (int, char*[])
+{
+    std::cout << "Bass Onboard benchmarks: " << sampleRate / 1000.0 << " kHz, " << blockSize << "-sample blocks" << std::endl;
+
+    auto input = makeInput();
+
+    benchmarkFilters     ( input );
+    benchmarkDistortion  ( input );
+    benchmarkBitCrusher  ( input );
+    benchmarkWavetable   ( input );
+    benchmarkOSCDispatch ();
+
+    // Printed so none of the work above can be optimised away
+    std::cout << "\n(checksum " << sink << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    AllocationTracker.cpp
+    Created: 17 Oct 2026 9:12:40am
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#include "AllocationTracker.h"
+
+#if BASS_ONBOARD_TRACK_ALLOCATIONS
+
+namespace
+{
+    thread_local int numAllocations = 0;
+    thread_local int trackingDepth  = 0;
+
+    void countAllocation()
+    {
+        if (trackingDepth > 0)
+            ++numAllocations;
+    }
+}
+
+//=============== malloc wrappers (Linux, see AllocationTracker.h) ==
+
+#if BASS_ONBOARD_WRAP_MALLOC
+
+extern "C"
+{
+    void* __real_malloc  (std::size_t size);
+    void* __real_calloc  (std::size_t count, std::size_t size);
+    void* __real_realloc (void* ptr, std::size_t size);
+
+    void* __wrap_malloc (std::size_t size)
+    {
+        countAllocation();
+        return __real_malloc ( size );
+    }
+
+    void* __wrap_calloc (std::size_t count, std::size_t size)
+    {
+        countAllocation();
+        return __real_calloc ( count, size );
+    }
+
+    void* __wrap_realloc (void* ptr, std::size_t size)
+    {
+        countAllocation();
+        return __real_realloc ( ptr, size );
+    }
+}
+
+#endif
+
+//=============== Global new/delete replacements ===================
+
+namespace
+{
+    /// Untracked malloc: operator new counts for itself, so it mustn't be counted twice by the wrapper
+    void* rawMalloc(std::size_t size)
+    {
+       #if BASS_ONBOARD_WRAP_MALLOC
+        return __real_malloc ( size == 0 ? 1 : size );
+       #else
+        return std::malloc ( size == 0 ? 1 : size );
+       #endif
+    }
+
+   #if __cpp_aligned_new
+    void* rawAlignedMalloc(std::size_t size, std::align_val_t alignment)
+    {
+        void* ptr = nullptr;
+
+        // posix_memalign wants at least pointer alignment
+        std::size_t align = std::max ( static_cast<std::size_t>( alignment ), sizeof ( void* ) );
+
+        return posix_memalign ( &ptr, align, size == 0 ? 1 : size ) == 0 ? ptr : nullptr;
+    }
+   #endif
+}
+
+void* operator new (std::size_t size)
+{
+    countAllocation();
+
+    if (void* ptr = rawMalloc ( size ))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    return operator new ( size );
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    countAllocation();
+    return rawMalloc ( size );
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept
+{
+    return operator new ( size, std::nothrow );
+}
+
+#if __cpp_aligned_new
+void* operator new (std::size_t size, std::align_val_t alignment)
+{
+    countAllocation();
+
+    if (void* ptr = rawAlignedMalloc ( size, alignment ))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment)
+{
+    return operator new ( size, alignment );
+}
+
+void* operator new (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    countAllocation();
+    return rawAlignedMalloc ( size, alignment );
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return operator new ( size, alignment, std::nothrow );
+}
+
+#endif
+
+// Everything above comes from malloc or posix_memalign, so free( ) releases all of it
+void operator delete   (void* ptr) noexcept                                          { std::free ( ptr ); }
+void operator delete[] (void* ptr) noexcept                                          { std::free ( ptr ); }
+void operator delete   (void* ptr, std::size_t) noexcept                             { std::free ( ptr ); }
+void operator delete[] (void* ptr, std::size_t) noexcept                             { std::free ( ptr ); }
+void operator delete   (void* ptr, const std::nothrow_t&) noexcept                   { std::free ( ptr ); }
+void operator delete[] (void* ptr, const std::nothrow_t&) noexcept                   { std::free ( ptr ); }
+
+#if __cpp_aligned_new
+void operator delete   (void* ptr, std::align_val_t) noexcept                        { std::free ( ptr ); }
+void operator delete[] (void* ptr, std::align_val_t) noexcept                        { std::free ( ptr ); }
+void operator delete   (void* ptr, std::size_t, std::align_val_t) noexcept           { std::free ( ptr ); }
+void operator delete[] (void* ptr, std::size_t, std::align_val_t) noexcept           { std::free ( ptr ); }
+void operator delete   (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free ( ptr ); }
+void operator delete[] (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free ( ptr ); }
+#endif
+
+
+//=============== AllocationTracker ================================
+
+int AllocationTracker::getNumAllocations()
+{
+    return numAllocations;
+}
+
+AllocationTracker::ScopedAudioThreadCheck::ScopedAudioThreadCheck() :
+    allocationsAtStart ( numAllocations )
+{
+    ++trackingDepth;
+}
+
+AllocationTracker::ScopedAudioThreadCheck::~ScopedAudioThreadCheck()
+{
+    --trackingDepth;
+
+    // If you hit this, something in processBlock allocated on the heap
+    jassert ( numAllocations == allocationsAtStart );
+}
+
+#else
+
+int AllocationTracker::getNumAllocations()
+{
+    return 0;
+}
+
+#endif
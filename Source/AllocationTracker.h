@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    AllocationTracker.h
+    Created: 17 Oct 2026 9:12:40am
+    Author:  Robert Fullum
+
+    Debug helper for catching heap allocations on the audio thread.
+
+    Add BASS_ONBOARD_TRACK_ALLOCATIONS=1 to the Projucer preprocessor
+    definitions of a Debug build. Global operator new/delete (plain, array,
+    nothrow and aligned) are then replaced with counting versions, and a
+    ScopedAudioThreadCheck asserts if anything was allocated while it was in
+    scope. With the flag off (the default) the check compiles away to nothing.
+
+    juce::HeapBlock, and with it AudioBuffer::setSize( ) and makeCopyOf( ),
+    calls malloc directly rather than new. On Linux (the Pi) those calls are
+    counted too, by wrapping malloc, calloc and realloc at link time: add
+
+        -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+
+    to the exporter's extra linker flags along with the definition. Without
+    them the Linux build fails to link rather than silently missing mallocs.
+    Other platforms only count operator new.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef BASS_ONBOARD_TRACK_ALLOCATIONS
+ #define BASS_ONBOARD_TRACK_ALLOCATIONS 0
+#endif
+
+#if BASS_ONBOARD_TRACK_ALLOCATIONS && JUCE_LINUX
+ #define BASS_ONBOARD_WRAP_MALLOC 1
+#else
+ #define BASS_ONBOARD_WRAP_MALLOC 0
+#endif
+
+namespace AllocationTracker
+{
+    /// Returns the number of tracked allocations made on the calling thread
+    int getNumAllocations();
+
+    /// Counts allocations on the calling thread while in scope, and asserts there were none
+    class ScopedAudioThreadCheck
+    {
+    public:
+       #if BASS_ONBOARD_TRACK_ALLOCATIONS
+        ScopedAudioThreadCheck();
+        ~ScopedAudioThreadCheck();
+
+    private:
+        int allocationsAtStart;
+       #else
+        ScopedAudioThreadCheck() {}
+       #endif
+    };
+}
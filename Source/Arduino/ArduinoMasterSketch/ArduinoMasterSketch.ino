@@ -12,7 +12,8 @@
  *    - 4 button bank (Filter parameter controls)
  *    - 2 Encoder twist + push button (parameter value & function selection)
  *    
- *  Connects to WiFi network and uses UDP to communicate OSC Bundles/Messages to Juce App
+ *  Connects to WiFi network and uses UDP to communicate OSC Bundles/Messages to Juce App,
+ *  or, with USE_BINARY_FRAMES set, one 124 byte binary frame per loop (see SensorFrame.h)
  *  
  *  
  */
@@ -166,6 +167,14 @@ const unsigned int destPort = 9001;     // Destination Port
 // OSC Bundle
 OSCBundle bndl;
 
+// Binary frames: 1 sends SensorFrames to framePort, 0 sends the OSC bundle to destPort
+#define USE_BINARY_FRAMES 1
+
+const unsigned int framePort = 9002;      // Destination Port for binary frames
+const int          frameSize = 124;       // 16 byte header + 26 floats + button mask
+
+uint32_t frameSequence = 0;
+
 
 
 // ~~~ SENSOR SECTION ~~~ 
@@ -235,8 +244,12 @@ void loop()
   filterButtonController();
   encoderButtonController();
 
-  // OSC Send
+  // Send
+#if USE_BINARY_FRAMES
+  sendBinaryFrame();
+#else
   sendOSCBundle();
+#endif
 }
 
 
@@ -567,6 +580,88 @@ void sendOSCBundle()
 
 
 
+// ~~~ BINARY FRAME ~~~ 
+// Writes a 32 bit value little-endian
+void writeUInt32( uint8_t* dest, uint32_t value )
+{
+  dest[0] =   value         & 0xff;
+  dest[1] = ( value >> 8  ) & 0xff;
+  dest[2] = ( value >> 16 ) & 0xff;
+  dest[3] = ( value >> 24 ) & 0xff;
+}
+
+void writeFloat( uint8_t* dest, float value )
+{
+  uint32_t bits;
+  memcpy( &bits, &value, 4 );
+  writeUInt32( dest, bits );
+}
+
+// Same values as sendOSCBundle(), in the order of OSCHandler::Slot in the Juce App
+void sendBinaryFrame()
+{
+  uint8_t frame[frameSize];
+
+  // Header: magic, version 1, 26 values, sequence, timestamp
+  frame[0] = 'B';
+  frame[1] = 'O';
+  frame[2] = 'S';
+  frame[3] = 'F';
+  frame[4] = 1;
+  frame[5] = 0;
+  frame[6] = 26;
+  frame[7] = 0;
+
+  writeUInt32( frame + 8,  frameSequence++ );
+  writeUInt32( frame + 12, micros() );
+
+  float values[26] = { accelX, accelY, accelZ,
+                       gyroX,  gyroY,  gyroZ,
+                       distance,
+                       touchX, touchY, touchZ,
+                       accelXOnOff, accelYOnOff, accelZOnOff,
+                       gyroXOnOff,  gyroYOnOff,  gyroZOnOff,
+                       touchScreenXOnOff, touchScreenYOnOff, touchScreenZOnOff,
+                       distanceOnOff,
+                       filterType, filterPoles,
+                       (float)encoderValue1, (float)encoderValue2,
+                       encButton1, encButton2 };
+
+  for (int i = 0; i < 26; i++)
+  {
+    writeFloat( frame + 16 + i * 4, values[i] );
+  }
+
+  // Held buttons: sensor bank bits 0-9, filter bank 10-13, encoder buttons 14-15
+  uint32_t buttonMask = 0;
+
+  for (int i = 0; i < SENSOR_BUTTONS_TOTAL; i++)
+  {
+    if (sensorButtons.isPressed(i))
+      buttonMask |= 1ul << i;
+  }
+
+  for (int i = 0; i < FILTER_BUTTONS_TOTAL; i++)
+  {
+    if (filterButtons.isPressed(i))
+      buttonMask |= 1ul << ( 10 + i );
+  }
+
+  for (int i = 0; i < ENCODER_BUTTONS_TOTAL; i++)
+  {
+    if (encoderButtons.isPressed(i))
+      buttonMask |= 1ul << ( 14 + i );
+  }
+
+  writeUInt32( frame + 120, buttonMask );
+
+  udp.beginPacket( computerIP, framePort );
+  udp.write( frame, frameSize );
+  udp.endPacket();
+}
+
+
+
 // Actually called in rotaryEncoderSetup() in setup() but because it's an interrupt
 // it happens while the loop() is running
 void updateEncoder()
@@ -13,9 +13,21 @@
 //=============== Public ======================================
 
 BitCrusher::BitCrusher() :
-    dryWet   ( std::make_unique<DryWet>()          ),
-    squareWT ( std::make_unique<SquareWavetable>() ),
-    sampleRate ( 44100.0f )
+    dryWet         ( std::make_unique<DryWet>() ),
+    sampleRate     ( 44100.0f ),
+    phase          ( 0        ),
+    phaseIncrement ( 0        ),
+    heldSample     ( 0.0f     ),
+    useBLEP        ( false    ),
+    pendingSample  ( 0.0f     ),
+    previousInput  ( 0.0f     ),
+    delayedDry     ( 0.0f     ),
+    quantiseActive ( false    ),
+    quantiseScale  ( 32768.0f ),
+    quantiseStep   ( 1.0f / 32768.0f ),
+    ditherMode     ( noDither ),
+    randomState    ( 0x9e3779b9 ),
+    shapingError   ( 0.0f     )
 {}
 
 BitCrusher::~BitCrusher() {}
@@ -28,110 +40,100 @@ void BitCrusher::prepare(float SR)
     dryWetSmooth.reset          ( sampleRate, 0.01f );
     dryWetSmooth.setTargetValue ( 0.0f );
     
-    setWavetables();
+    reset();
 }
 
-/// Takes AudioBuffer and crush amount (0 to 1). Returns bitcrushed AudioBuffer. onOff is 0 or 1 from ParameterChoice
-juce::AudioBuffer<float> BitCrusher::process(juce::AudioBuffer<float> &bufferIn, float crushAmt, float dryWetVal)
+/// Takes AudioBuffer and crush amount (0 to 1). Bitcrushes the (mono) buffer in place
+void BitCrusher::processBuffer(juce::AudioBuffer<float> &bufferIn, float crushAmt, float dryWetVal)
 {
-    float crushMapped = juce::jmap ( crushAmt, 1.0f, sampleRate );
-    float crushFreq   = juce::jmap ( sampleRate / crushMapped, 1.0f, sampleRate, 20.0f, sampleRate );    // in Hz
+    if (! prepareBlock ( crushAmt, dryWetVal ))
+        return;
     
-    squareWT->setIncrement ( crushFreq );
+    auto* monoChan   = bufferIn.getWritePointer ( 0 );
+    int   numSamples = bufferIn.getNumSamples();
     
-    return crush ( bufferIn, dryWetVal );
+    // Settled mix: work the gains out once for the block
+    if (! dryWetSmooth.isSmoothing())
+    {
+        float dryGain = dryWet->equalPowerGain ( 1.0f - dryWetSmooth.getCurrentValue() );
+        float wetGain = dryWet->equalPowerGain ( dryWetSmooth.getCurrentValue() );
+        
+        for (int sample = 0; sample < numSamples; sample++)
+        {
+            float dry;
+            float wet        = crushSample ( monoChan[sample], dry );
+            monoChan[sample] = dry * dryGain + wet * wetGain;
+        }
+        
+        return;
+    }
+    
+    for (int sample = 0; sample < numSamples; sample++)
+        monoChan[sample] = processSample ( monoChan[sample] );
 }
 
 
-void BitCrusher::processBuffer(juce::AudioBuffer<float> &bufferIn, float crushAmt, float dryWetVal)
+bool BitCrusher::prepareBlock(float crushAmt, float dryWetVal)
 {
     float crushMapped = juce::jmap ( crushAmt, 1.0f, sampleRate );
     float crushFreq   = juce::jmap ( sampleRate / crushMapped, 1.0f, sampleRate, 20.0f, sampleRate );    // in Hz
     
-    squareWT->setIncrement ( crushFreq );
+    // Fraction of a hold period per sample, in 1/2^32 turns. At the sample rate or above every sample is held
+    double turnsPerSample = juce::jlimit ( 0.0, 1.0, static_cast<double>( crushFreq ) / sampleRate );
+    phaseIncrement        = static_cast<juce::uint32>( turnsPerSample * 4294967295.0 );
     
-    crushBuffer ( bufferIn, dryWetVal);
+    dryWetSmooth.setTargetValue ( dryWetVal );
+    
+    // Fully dry: skip the stage. Anti-aliased mode keeps running so its one sample of latency never changes
+    return useBLEP || ! DryWet::isFullyDry ( dryWetSmooth );
 }
 
-//================= Private ===================================
 
-/// Populates Wavetable
-void BitCrusher::setWavetables()
+/// Restarts the hold clock so the next sample is captured
+void BitCrusher::reset()
 {
-    squareWT->setSampleRate     ( sampleRate );
-    squareWT->populateWavetable ();
+    phase        = 0xffffffff;
+    heldSample    = 0.0f;
+    shapingError  = 0.0f;
+    pendingSample = 0.0f;
+    previousInput = 0.0f;
+    delayedDry    = 0.0f;
 }
 
 
-
-juce::AudioBuffer<float> BitCrusher::crush(juce::AudioBuffer<float> &bufferIn, float dryWetAmt)
+/// Sets the quantiser bit depth (1 to 16, 16 = off) and DitherMode
+void BitCrusher::setBitDepth(float bitDepth, int newDitherMode)
 {
-    auto* leftChan  = bufferIn.getWritePointer ( 0 );
-    auto* rightChan = bufferIn.getWritePointer ( 1 );
+    bitDepth = juce::jlimit ( 1.0f, 16.0f, bitDepth );
     
-    dryWetSmooth.setTargetValue ( dryWetAmt );
+    // Signed: half the levels on each side of zero
+    quantiseActive = bitDepth < 16.0f;
+    quantiseScale  = std::exp2 ( bitDepth - 1.0f );
+    quantiseStep   = 1.0f / quantiseScale;
     
-    for (int chan = 0; chan < bufferIn.getNumChannels(); chan++)
-    {
-        for (int sample = 0; sample < bufferIn.getNumSamples(); sample++)
-        {
-            float outVal;
-            float crushVal  = squareWT->process();
-            float sampleVal = bufferIn.getSample( chan, sample );
-            float holdVal   = 0.0f;
-            
-            if (crushVal >= 0.0f)
-            {
-                outVal  = sampleVal;
-                holdVal = outVal;
-            }
-            else
-                outVal = holdVal;
-            
-            float mixedSample = dryWet->dryWetMixEqualPowerBySample( sampleVal, outVal, dryWetSmooth.getNextValue() );
-            
-            if (chan == 0)
-                leftChan[sample]  = mixedSample;
-            else if (chan == 1)
-                rightChan[sample] = mixedSample;
-        }
-    }
+    if (newDitherMode != ditherMode)
+        shapingError = 0.0f;
     
-    return  bufferIn;
+    ditherMode = juce::jlimit ( 0, 2, newDitherMode );
 }
 
 
-void BitCrusher::crushBuffer(juce::AudioBuffer<float> &bufferIn, float dryWetAmt)
+/// Switches between hard sample and hold and polyBLEP-corrected hold steps
+void BitCrusher::setAntiAliasing(bool shouldUseBLEP)
 {
-    auto* leftChan  = bufferIn.getWritePointer ( 0 );
-    auto* rightChan = bufferIn.getWritePointer ( 1 );
+    if (shouldUseBLEP == useBLEP)
+        return;
     
-    dryWetSmooth.setTargetValue ( dryWetAmt );
+    useBLEP = shouldUseBLEP;
     
-    for (int chan = 0; chan < bufferIn.getNumChannels(); chan++)
-    {
-        for (int sample = 0; sample < bufferIn.getNumSamples(); sample++)
-        {
-            float outVal    = 0.0f;
-            float crushVal  = squareWT->process();
-            float sampleVal = bufferIn.getSample( chan, sample );
-            float holdVal   = 0.0f;
-            
-            if (crushVal >= 0.0f)
-            {
-                outVal  = sampleVal;
-                holdVal = outVal;
-            }
-            else
-                outVal = holdVal;
-            
-            float mixedSample = dryWet->dryWetMixEqualPowerBySample( sampleVal, outVal, dryWetSmooth.getNextValue() );
-            
-            if (chan == 0)
-                leftChan[sample]  = mixedSample;
-            else if (chan == 1)
-                rightChan[sample] = mixedSample;
-        }
-    }
+    // Carry on from the current hold value without a step
+    pendingSample = heldSample;
+    delayedDry    = previousInput;
 }
 
+
+/// Returns the stage latency: 1 sample in anti-aliased mode, otherwise 0
+int BitCrusher::getLatencySamples() const
+{
+    return useBLEP ? 1 : 0;
+}
@@ -12,41 +12,191 @@
 
 #include <JuceHeader.h>
 #include "DryWet.h"
-#include "Wavetable.h"
 
+/**
+ Sample-rate reduction: a 32 bit phase accumulator runs at the crush rate and the
+ input is sampled and held each time it wraps. Integer wrap detection keeps the
+ hold timing exact and free of drift.
+
+ The held signal can then be quantised to 1-16 bits (fractional depths allowed),
+ optionally with TPDF or first-order noise-shaped dither from an xorshift RNG.
+
+ In anti-aliased mode each hold step is placed at its exact (fractional) time and
+ smoothed with a two-sample polyBLEP, which needs one sample of lookahead: the
+ stage then reports one sample of latency and delays its dry path to match.
+ */
 class BitCrusher
 {
 public:
+    enum DitherMode
+    {
+        noDither = 0,
+        tpdfDither,
+        noiseShapedDither
+    };
+    
     BitCrusher();
     ~BitCrusher();
     
     /// Sets up BitCrusher class
     void prepare(float SR);
     
-    /// Takes AudioBuffer and crush amount (0 to 1). Returns bitcrushed AudioBuffer. onOff is 0 or 1 from ParameterChoice
-    juce::AudioBuffer<float> process(juce::AudioBuffer<float>& bufferIn, float crushAmt, float dryWetVal);
-    
+    /// Takes AudioBuffer and crush amount (0 to 1). Bitcrushes the (mono) buffer in place
     void processBuffer(juce::AudioBuffer<float>& bufferIn, float crushAmt, float dryWetVal);
     
+    /**
+     Sets the crush rate and dry/wet target for the next block. Returns false if the stage is fully dry,
+     in which case processSample( ) must not be called for this block
+     */
+    bool prepareBlock(float crushAmt, float dryWetVal);
+    
+    /// Crushes and dry/wet mixes a single sample. Call after prepareBlock( ) returned true
+    inline float processSample(float sampleIn);
+    
+    /// Restarts the hold clock so the next sample is captured
+    void reset();
+    
+    /// Sets the quantiser bit depth (1 to 16, 16 = off) and DitherMode
+    void setBitDepth(float bitDepth, int newDitherMode);
+    
+    /// Switches between hard sample and hold and polyBLEP-corrected hold steps
+    void setAntiAliasing(bool shouldUseBLEP);
+    
+    /// Returns the stage latency: 1 sample in anti-aliased mode, otherwise 0
+    int getLatencySamples() const;
+    
 private:
-    /// Populates Wavetable
-    void setWavetables();
+    /// Runs the hold clock (hard or polyBLEP) and the quantiser. dryOut receives the dry sample aligned with it
+    inline float crushSample(float sampleIn, float& dryOut);
+    
+    /// Advances the hold clock one sample and returns the held value
+    inline float sampleAndHold(float sampleIn);
     
-    juce::AudioBuffer<float> crush(juce::AudioBuffer<float> &bufferIn, float dryWetAmt);
+    /// As sampleAndHold( ), but with polyBLEP-corrected steps. Output is one sample late
+    inline float sampleAndHoldBLEP(float sampleIn);
     
-    void crushBuffer(juce::AudioBuffer<float> &bufferIn, float dryWetAmt);
+    /// Quantises to the current bit depth with the current dither
+    inline float quantise(float sampleIn);
     
-    std::unique_ptr<DryWet>          dryWet;
-    std::unique_ptr<SquareWavetable> squareWT;
+    /// xorshift32, scaled to [0, 1)
+    inline float nextRandom();
+    
+    std::unique_ptr<DryWet> dryWet;
 
     // Member Variables
     float sampleRate;
     
+    // Hold clock: a full turn of the accumulator is one hold period
+    juce::uint32 phase;
+    juce::uint32 phaseIncrement;
+    float        heldSample;
+    
+    // PolyBLEP hold: the sample waiting for its correction, the last input and the last dry
+    bool         useBLEP;
+    float        pendingSample;
+    float        previousInput;
+    float        delayedDry;
+    
+    // Quantiser: levels per unit and its inverse, the step size
+    bool         quantiseActive;
+    float        quantiseScale;
+    float        quantiseStep;
+    int          ditherMode;
+    juce::uint32 randomState;
+    float        shapingError;
+    
     juce::SmoothedValue<float> dryWetSmooth;
-    juce::AudioBuffer<float>   sampleBuffer;
 };
 
 
-//=========================================================
-//=========================================================
-//=========================================================
+inline float BitCrusher::sampleAndHold(float sampleIn)
+{
+    juce::uint32 nextPhase = phase + phaseIncrement;
+    
+    // The accumulator wrapped: take a new sample
+    heldSample = nextPhase < phase ? sampleIn : heldSample;
+    phase      = nextPhase;
+    
+    return heldSample;
+}
+
+
+inline float BitCrusher::sampleAndHoldBLEP(float sampleIn)
+{
+    juce::uint32 nextPhase = phase + phaseIncrement;
+    float        outVal    = pendingSample;
+    
+    if (nextPhase < phase)
+    {
+        // How far past the wrap this sample is, as a fraction of a sample
+        float fraction = static_cast<float>( nextPhase ) / static_cast<float>( phaseIncrement );
+        
+        // Sample the input at the wrap itself, then spread the step over the samples either side
+        float newHeld  = sampleIn - fraction * ( sampleIn - previousInput );
+        float step     = newHeld - heldSample;
+        
+        outVal        += step * 0.5f * fraction * fraction;
+        heldSample     = newHeld;
+        pendingSample  = newHeld - step * 0.5f * ( 1.0f - fraction ) * ( 1.0f - fraction );
+    }
+    else
+        pendingSample = heldSample;
+    
+    phase         = nextPhase;
+    previousInput = sampleIn;
+    
+    return outVal;
+}
+
+
+inline float BitCrusher::crushSample(float sampleIn, float& dryOut)
+{
+    if (! useBLEP)
+    {
+        dryOut = sampleIn;
+        return quantise ( sampleAndHold ( sampleIn ) );
+    }
+    
+    dryOut     = delayedDry;
+    delayedDry = sampleIn;
+    
+    return quantise ( sampleAndHoldBLEP ( sampleIn ) );
+}
+
+
+inline float BitCrusher::nextRandom()
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    
+    return static_cast<float>( randomState >> 8 ) * ( 1.0f / 16777216.0f );
+}
+
+
+inline float BitCrusher::quantise(float sampleIn)
+{
+    if (! quantiseActive)
+        return sampleIn;
+    
+    // Triangular dither spanning +-1 LSB
+    float dither = ditherMode == noDither ? 0.0f : ( nextRandom() - nextRandom() ) * quantiseStep;
+    
+    // Noise shaping feeds the last quantisation error back, pushing the noise up in frequency
+    float shaped    = sampleIn - shapingError;
+    float quantised = std::floor ( ( shaped + dither ) * quantiseScale + 0.5f ) * quantiseStep;
+    
+    if (ditherMode == noiseShapedDither)
+        shapingError = quantised - shaped;
+    
+    return quantised;
+}
+
+
+inline float BitCrusher::processSample(float sampleIn)
+{
+    float dry;
+    float wet = crushSample ( sampleIn, dry );
+    
+    return dryWet->mixEqualPower ( dry, wet, dryWetSmooth.getNextValue() );
+}
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    ControlRateFilter.cpp
+    Created: 17 Oct 2026 10:02:15am
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#include "ControlRateFilter.h"
+
+namespace
+{
+    // Matches getControlIntervalNames( )
+    const int controlIntervals[] = { 1, 4, 8, 16, 32, 64 };
+}
+
+ControlRateFilter::ControlRateFilter() :
+    filterType         ( juce::dsp::StateVariableTPTFilterType::lowpass ),
+    sampleRate         ( 44100.0 ),
+    controlInterval    ( 16      ),
+    samplesUntilUpdate ( 0       ),
+    hasTargets         ( false   ),
+    g                  ( 0.0f    ),
+    R2                 ( 0.0f    ),
+    gStep              ( 0.0f    ),
+    R2Step             ( 0.0f    ),
+    s1                 ( 0.0f    ),
+    s2                 ( 0.0f    )
+{}
+
+ControlRateFilter::~ControlRateFilter() {}
+
+
+/// Control period choices (in samples) for the "filterControlRate" parameter
+juce::StringArray ControlRateFilter::getControlIntervalNames()
+{
+    return { "1", "4", "8", "16", "32", "64" };
+}
+
+
+/// Returns the control period, in samples, for a getControlIntervalNames( ) index
+int ControlRateFilter::getControlIntervalForIndex(int index)
+{
+    return controlIntervals[juce::jlimit ( 0, 5, index )];
+}
+
+
+/// Sets the sample rate and clears the filter state
+void ControlRateFilter::prepare(const juce::dsp::ProcessSpec &spec)
+{
+    sampleRate = spec.sampleRate;
+
+    reset();
+}
+
+
+/// Clears the filter state. The next setTargets( ) jumps straight to its targets
+void ControlRateFilter::reset()
+{
+    s1 = 0.0f;
+    s2 = 0.0f;
+
+    // Coefficients left over from before the reset may be stale, and with no state to disturb there's nothing to ramp from
+    hasTargets         = false;
+    samplesUntilUpdate = 0;
+}
+
+
+/// Sets lowpass, bandpass or highpass response
+void ControlRateFilter::setType(juce::dsp::StateVariableTPTFilterType newType)
+{
+    filterType = newType;
+}
+
+
+/// Sets the number of samples between coefficient updates. 1 updates every sample
+void ControlRateFilter::setControlInterval(int numSamples)
+{
+    controlInterval    = juce::jmax ( 1, numSamples );
+    samplesUntilUpdate = 0;
+}
+
+
+/// Returns the number of samples between coefficient updates
+int ControlRateFilter::getControlInterval() const
+{
+    return controlInterval;
+}
+
+
+/// Returns true when the current control period has run out and setTargets( ) should be called
+bool ControlRateFilter::isUpdateDue() const
+{
+    return samplesUntilUpdate <= 0;
+}
+
+
+/// Sets cutoff (Hz) and resonance targets, reached by the end of the next control period
+void ControlRateFilter::setTargets(float cutoffHz, float resonance)
+{
+    float cutoff   = juce::jlimit ( 1.0f, static_cast<float>( sampleRate * 0.49 ), cutoffHz );
+    float targetG  = static_cast<float>( std::tan ( juce::MathConstants<double>::pi * cutoff / sampleRate ) );
+    float targetR2 = 1.0f / juce::jmax ( 0.01f, resonance );
+
+    if (hasTargets)
+    {
+        gStep  = ( targetG  - g  ) / controlInterval;
+        R2Step = ( targetR2 - R2 ) / controlInterval;
+    }
+    else
+    {
+        // First update after prepare( ) or reset( ): jump straight to the target
+        g          = targetG;
+        R2         = targetR2;
+        gStep      = 0.0f;
+        R2Step     = 0.0f;
+        hasTargets = true;
+    }
+
+    samplesUntilUpdate = controlInterval;
+}
+
+
+/// Filters one sample, stepping the coefficient ramp
+float ControlRateFilter::processSample(float sampleIn)
+{
+    if (samplesUntilUpdate > 0)
+    {
+        g  += gStep;
+        R2 += R2Step;
+
+        --samplesUntilUpdate;
+    }
+
+    float h = 1.0f / ( 1.0f + R2 * g + g * g );
+
+    float yHP = h * ( sampleIn - s1 * ( g + R2 ) - s2 );
+    float yBP = yHP * g + s1;
+    s1        = yHP * g + yBP;
+    float yLP = yBP * g + s2;
+    s2        = yBP * g + yLP;
+
+    switch (filterType)
+    {
+        case juce::dsp::StateVariableTPTFilterType::bandpass :
+            return yBP;
+        case juce::dsp::StateVariableTPTFilterType::highpass :
+            return yHP;
+        case juce::dsp::StateVariableTPTFilterType::lowpass :
+        default:
+            return yLP;
+    }
+}
+
+
+/// Flushes denormals out of the filter state
+void ControlRateFilter::snapToZero()
+{
+    juce::dsp::util::snapToZero ( s1 );
+    juce::dsp::util::snapToZero ( s2 );
+}
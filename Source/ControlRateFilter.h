@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    ControlRateFilter.h
+    Created: 17 Oct 2026 10:02:15am
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Mono TPT state variable filter (same topology as juce::dsp::StateVariableTPTFilter)
+ whose coefficients are only recomputed at control rate.
+
+ Every controlInterval samples setTargets( ) runs the tan( ) for a new cutoff, and
+ the g and R2 coefficients ramp linearly to it over the following control period,
+ so a swept cutoff stays smooth without paying for tan( ) on every sample.
+ */
+class ControlRateFilter
+{
+public:
+    ControlRateFilter();
+    ~ControlRateFilter();
+
+    /// Control period choices (in samples) for the "filterControlRate" parameter
+    static juce::StringArray getControlIntervalNames();
+
+    /// Returns the control period, in samples, for a getControlIntervalNames( ) index
+    static int getControlIntervalForIndex(int index);
+
+    /// Sets the sample rate and clears the filter state
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    /// Clears the filter state. The next setTargets( ) jumps straight to its targets
+    void reset();
+
+    /// Sets lowpass, bandpass or highpass response
+    void setType(juce::dsp::StateVariableTPTFilterType newType);
+
+    /// Sets the number of samples between coefficient updates. 1 updates every sample
+    void setControlInterval(int numSamples);
+
+    /// Returns the number of samples between coefficient updates
+    int getControlInterval() const;
+
+    /// Returns true when the current control period has run out and setTargets( ) should be called
+    bool isUpdateDue() const;
+
+    /// Sets cutoff (Hz) and resonance targets, reached by the end of the next control period
+    void setTargets(float cutoffHz, float resonance);
+
+    /// Filters one sample, stepping the coefficient ramp
+    float processSample(float sampleIn);
+
+    /// Flushes denormals out of the filter state
+    void snapToZero();
+
+private:
+    juce::dsp::StateVariableTPTFilterType filterType;
+
+    double sampleRate;
+    int    controlInterval;
+    int    samplesUntilUpdate;
+    bool   hasTargets;
+
+    // Coefficients and their per-sample ramp steps
+    float g;
+    float R2;
+    float gStep;
+    float R2Step;
+
+    // Integrator states
+    float s1;
+    float s2;
+};
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    DistortionChain.cpp
+    Created: 17 Oct 2026 11:20:48am
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#include "DistortionChain.h"
+
+DistortionChain::DistortionChain() :
+    waveShaper          ( std::make_unique<WaveShaper>()         ),
+    foldback            ( std::make_unique<FoldbackDistortion>() ),
+    bitCrush            ( std::make_unique<BitCrusher>()         ),
+    sampleRate          ( 44100.0f ),
+    currentOversampling ( 0        )
+{}
+
+DistortionChain::~DistortionChain() {}
+
+
+/// Sets sample rate and block size for all three stages, and allocates the oversamplers
+void DistortionChain::prepare(const juce::dsp::ProcessSpec &spec)
+{
+    sampleRate = static_cast<float>( spec.sampleRate );
+
+    oversamplers.clear();
+
+    for (size_t factorLog2 = 1; factorLog2 <= 3; factorLog2++)
+    {
+        auto* os = oversamplers.add ( new juce::dsp::Oversampling<float> ( 1, factorLog2,
+                                                                           juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR ) );
+        os->initProcessing ( spec.maximumBlockSize );
+    }
+
+    // The oversampled stages run at sampleRate * factor
+    int factor = 1 << currentOversampling;
+
+    waveShaper->setSampleRate ( sampleRate * factor );
+    foldback->setSampleRate   ( sampleRate * factor );
+    bitCrush->prepare         ( sampleRate );
+}
+
+
+/// Sets oversampling of the waveshaper and foldback: 0 = off, 1 = 2x, 2 = 4x, 3 = 8x
+void DistortionChain::setOversampling(int oversamplingIndex)
+{
+    oversamplingIndex = juce::jlimit ( 0, oversamplers.size(), oversamplingIndex );
+
+    if (oversamplingIndex == currentOversampling)
+        return;
+
+    currentOversampling = oversamplingIndex;
+
+    int factor = 1 << currentOversampling;
+
+    waveShaper->setSampleRate ( sampleRate * factor );
+    foldback->setSampleRate   ( sampleRate * factor );
+
+    if (currentOversampling > 0)
+        oversamplers[currentOversampling - 1]->reset();
+}
+
+
+/// Sets anti-aliasing per stage: 0 = standard, 1 = first-order ADAA
+void DistortionChain::setAntiAliasing(int waveshapeQuality, int foldbackQuality)
+{
+    waveShaper->setAntiAliasing ( waveshapeQuality == 1 );
+    foldback->setAntiAliasing   ( foldbackQuality  == 1 );
+}
+
+
+/// Selects the waveshaper transfer curve, see ShaperTables::Curve
+void DistortionChain::setWaveshapeCurve(int curveIndex)
+{
+    waveShaper->setCurve ( curveIndex );
+}
+
+
+/// Sets the bitcrusher's quantiser: bit depth 1 to 16 (16 = off) and BitCrusher::DitherMode
+void DistortionChain::setBitDepth(float bitDepth, int ditherMode)
+{
+    bitCrush->setBitDepth ( bitDepth, ditherMode );
+}
+
+
+/// Sets the bitcrusher's hold: 0 = hard, 1 = polyBLEP
+void DistortionChain::setCrushAntiAliasing(int crushQuality)
+{
+    bitCrush->setAntiAliasing ( crushQuality == 1 );
+}
+
+
+/// Returns the latency added by the current oversampling and bitcrusher settings, in samples at base rate
+int DistortionChain::getLatencySamples() const
+{
+    int crushLatency = bitCrush->getLatencySamples();
+
+    if (currentOversampling == 0)
+        return crushLatency;
+
+    return juce::roundToInt ( oversamplers[currentOversampling - 1]->getLatencyInSamples() ) + crushLatency;
+}
+
+
+/// Distorts the (mono) buffer in place
+void DistortionChain::processBuffer(juce::AudioBuffer<float> &bufferIn,
+                                    float wsAmount,       float wsDryWet,
+                                    float foldbackAmount, float foldbackDryWet,
+                                    float crushAmount,    float crushDryWet)
+{
+    int numSamples = bufferIn.getNumSamples();
+
+    if (currentOversampling > 0)
+    {
+        processOversampled ( bufferIn, wsAmount, wsDryWet, foldbackAmount, foldbackDryWet );
+
+        bitCrush->processBuffer ( bufferIn, crushAmount, crushDryWet );
+        return;
+    }
+
+    // Fully dry stages drop out of the loop for this block
+    bool wsActive    = waveShaper->prepareBlock ( wsAmount,       wsDryWet,       numSamples );
+    bool foldActive  = foldback->prepareBlock   ( foldbackAmount, foldbackDryWet, numSamples );
+    bool crushActive = bitCrush->prepareBlock   ( crushAmount,    crushDryWet                );
+
+    if (! wsActive && ! foldActive && ! crushActive)
+        return;
+
+    auto* monoChan = bufferIn.getWritePointer ( 0 );
+
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        float sampleVal = monoChan[sample];
+
+        if (wsActive)
+            sampleVal = waveShaper->processSample ( sampleVal );
+
+        if (foldActive)
+            sampleVal = foldback->processSample ( sampleVal );
+
+        if (crushActive)
+            sampleVal = bitCrush->processSample ( sampleVal );
+
+        monoChan[sample] = sampleVal;
+    }
+}
+
+
+/// Runs waveshaper and foldback on an oversampled block
+void DistortionChain::processOversampled(juce::AudioBuffer<float> &bufferIn,
+                                         float wsAmount,       float wsDryWet,
+                                         float foldbackAmount, float foldbackDryWet)
+{
+    auto& oversampler = *oversamplers[currentOversampling - 1];
+
+    // Up/down sampling always runs, even when both stages are dry, so the latency never changes
+    juce::dsp::AudioBlock<float> block   ( bufferIn );
+    juce::dsp::AudioBlock<float> upBlock = oversampler.processSamplesUp ( block );
+
+    int   upSamples = static_cast<int>( upBlock.getNumSamples() );
+    auto* upChan    = upBlock.getChannelPointer ( 0 );
+
+    bool wsActive   = waveShaper->prepareBlock ( wsAmount,       wsDryWet,       upSamples );
+    bool foldActive = foldback->prepareBlock   ( foldbackAmount, foldbackDryWet, upSamples );
+
+    if (wsActive || foldActive)
+    {
+        for (int sample = 0; sample < upSamples; sample++)
+        {
+            float sampleVal = upChan[sample];
+
+            if (wsActive)
+                sampleVal = waveShaper->processSample ( sampleVal );
+
+            if (foldActive)
+                sampleVal = foldback->processSample ( sampleVal );
+
+            upChan[sample] = sampleVal;
+        }
+    }
+
+    oversampler.processSamplesDown ( block );
+}
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    DistortionChain.h
+    Created: 17 Oct 2026 11:20:48am
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WaveShaper.h"
+#include "FoldbackDistortion.h"
+#include "BitCrusher.h"
+
+/**
+ Waveshaper -> Foldback -> BitCrusher as one fused stage.
+
+ Runs all three distortions (and their dry/wet mixes) in a single loop over the
+ buffer instead of three full passes. Each stage keeps its own smoothers and
+ state, so the output is the same as calling the three stages one after another.
+ The stages define their per-sample processSample( ) inline in their headers so
+ this loop compiles down to one body with no calls.
+
+ The waveshaper and foldback can be oversampled 2x, 4x or 8x (polyphase IIR) to
+ keep their harmonics from aliasing. The bitcrusher always runs at base rate:
+ its aliasing is the effect.
+ */
+class DistortionChain
+{
+public:
+    DistortionChain();
+    ~DistortionChain();
+
+    /// Sets sample rate and block size for all three stages, and allocates the oversamplers
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    /// Sets oversampling of the waveshaper and foldback: 0 = off, 1 = 2x, 2 = 4x, 3 = 8x
+    void setOversampling(int oversamplingIndex);
+
+    /// Sets anti-aliasing per stage: 0 = standard, 1 = first-order ADAA
+    void setAntiAliasing(int waveshapeQuality, int foldbackQuality);
+
+    /// Selects the waveshaper transfer curve, see ShaperTables::Curve
+    void setWaveshapeCurve(int curveIndex);
+
+    /// Sets the bitcrusher's quantiser: bit depth 1 to 16 (16 = off) and BitCrusher::DitherMode
+    void setBitDepth(float bitDepth, int ditherMode);
+
+    /// Sets the bitcrusher's hold: 0 = hard, 1 = polyBLEP
+    void setCrushAntiAliasing(int crushQuality);
+
+    /// Returns the latency added by the current oversampling and bitcrusher settings, in samples at base rate
+    int getLatencySamples() const;
+
+    /// Distorts the (mono) buffer in place
+    void processBuffer(juce::AudioBuffer<float>& bufferIn,
+                       float wsAmount,       float wsDryWet,
+                       float foldbackAmount, float foldbackDryWet,
+                       float crushAmount,    float crushDryWet);
+
+private:
+    /// Runs waveshaper and foldback on an oversampled block
+    void processOversampled(juce::AudioBuffer<float>& bufferIn,
+                            float wsAmount,       float wsDryWet,
+                            float foldbackAmount, float foldbackDryWet);
+
+    std::unique_ptr<WaveShaper>         waveShaper;
+    std::unique_ptr<FoldbackDistortion> foldback;
+    std::unique_ptr<BitCrusher>         bitCrush;
+
+    // One oversampler per factor (2x, 4x, 8x), all allocated in prepare( )
+    juce::OwnedArray<juce::dsp::Oversampling<float>> oversamplers;
+
+    float sampleRate;
+    int   currentOversampling;
+};
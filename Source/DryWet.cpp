@@ -11,6 +11,7 @@
 #include "DryWet.h"
 
 DryWet::DryWet() :
+    gainTable ( getSharedGainTable() ),
     drySample ( 0.0f ),
     wetSample ( 0.0f ),
     mixFactor ( 0.0f )
@@ -40,6 +41,53 @@ float DryWet::dryWetMixEqualPowerBySample(float dryIn, float wetIn, float mixVal
     return  dryWetCalculationEqualPower();
 }
 
+/**
+ Equal-power mixes a block: out = dry * dryGain * dryScale + wet * wetGain. out may alias dry or wet.
+ While mixSmooth is settled the gains are worked out once and applied with FloatVectorOperations;
+ while it ramps they are read per sample from the gain table.
+ */
+void DryWet::dryWetMixEqualPowerBlock(const float* dry, const float* wet, float* out, int numSamples,
+                                      juce::SmoothedValue<float>& mixSmooth, float dryScale)
+{
+    if (! mixSmooth.isSmoothing())
+    {
+        float mix     = mixSmooth.getCurrentValue();
+        float dryGain = equalPowerGain ( 1.0f - mix ) * dryScale;
+        float wetGain = equalPowerGain ( mix );
+        
+        // Scale whichever buffer out aliases first, so nothing is read after being overwritten
+        if (out == dry)
+        {
+            juce::FloatVectorOperations::multiply        ( out, dryGain, numSamples );
+            juce::FloatVectorOperations::addWithMultiply ( out, wet, wetGain, numSamples );
+        }
+        else
+        {
+            juce::FloatVectorOperations::multiply        ( out, wet, wetGain, numSamples );
+            juce::FloatVectorOperations::addWithMultiply ( out, dry, dryGain, numSamples );
+        }
+        
+        return;
+    }
+    
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        float mix = mixSmooth.getNextValue();
+        
+        out[sample] = dry[sample] * equalPowerGain ( 1.0f - mix ) * dryScale
+                    + wet[sample] * equalPowerGain ( mix );
+    }
+}
+
+/**
+ Returns true if the mix smoother has settled at fully dry, so a stage can skip its wet path.
+ Set the smoother's target for the block before calling
+ */
+bool DryWet::isFullyDry(const juce::SmoothedValue<float>& mixSmooth)
+{
+    return ! mixSmooth.isSmoothing() && mixSmooth.getCurrentValue() <= 0.0f;
+}
+
 /// Calculates gain of dry and wet samples. Returns mix sample (Linear by sample)
 float DryWet::dryWetCalculationLinear()
 {
@@ -52,8 +100,17 @@ float DryWet::dryWetCalculationLinear()
 /// Calculates gain of dry and wet samples. Returns mix sample (Equal Power by sample)
 float DryWet::dryWetCalculationEqualPower()
 {
-    float dryMix = std::sin ( 0.5f * juce::MathConstants<float>::pi * (1.0f - mixFactor) ) * drySample;
-    float wetMix = std::sin ( 0.5f * juce::MathConstants<float>::pi * mixFactor ) * wetSample;
-    
-    return dryMix + wetMix;
+    return mixEqualPower ( drySample, wetSample, mixFactor );
+}
+
+/// Returns the equal-power gain table shared by every DryWet instance
+const juce::dsp::LookupTableTransform<float>& DryWet::getSharedGainTable()
+{
+    // Built on first use, which is a DryWet constructor, never the audio thread
+    static const juce::dsp::LookupTableTransform<float> table ( [] (float mix)
+                                                                {
+                                                                    return std::sin ( 0.5f * juce::MathConstants<float>::pi * mix );
+                                                                },
+                                                                0.0f, 1.0f, 512 );
+    return table;
 }
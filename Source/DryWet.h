@@ -29,7 +29,37 @@ public:
     */
     float dryWetMixEqualPowerBySample(float dryIn, float wetIn, float mixVal);
     
+    /**
+     Equal-power mixes a block: out = dry * dryGain * dryScale + wet * wetGain. out may alias dry or wet.
+     While mixSmooth is settled the gains are worked out once and applied with FloatVectorOperations;
+     while it ramps they are read per sample from the gain table.
+     */
+    void dryWetMixEqualPowerBlock(const float* dry, const float* wet, float* out, int numSamples,
+                                  juce::SmoothedValue<float>& mixSmooth, float dryScale = 1.0f);
+    
+    /// Equal-power mix of a single sample using the gain table. Inline for per-sample effect loops
+    float mixEqualPower(float dryIn, float wetIn, float mixVal) const
+    {
+        return dryIn * equalPowerGain ( 1.0f - mixVal ) + wetIn * equalPowerGain ( mixVal );
+    }
+    
+    /// Returns sin(mixVal * pi/2) from the gain table: the wet gain for mixVal, or the dry gain for 1 - mixVal
+    float equalPowerGain(float mixVal) const
+    {
+        return gainTable.processSample ( mixVal );
+    }
+    
+    /**
+     Returns true if the mix smoother has settled at fully dry, so a stage can skip its wet path.
+     Set the smoother's target for the block before calling. The smoother ramping back up from 0
+     is what crossfades the stage back in.
+     */
+    static bool isFullyDry(const juce::SmoothedValue<float>& mixSmooth);
+    
 private:
+    /// Returns the equal-power gain table shared by every DryWet instance
+    static const juce::dsp::LookupTableTransform<float>& getSharedGainTable();
+    
     /// Calculates gain of dry and wet samples. Returns mix sample (Linear by sample)
     float dryWetCalculationLinear();
     
@@ -38,6 +68,8 @@ private:
     
 
     // member variables
+    const juce::dsp::LookupTableTransform<float>& gainTable;
+    
     float drySample;
     float wetSample;
     float mixFactor;
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    FoldKernel.h
+    Created: 17 Oct 2026 2:41:09pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Sine folding kernel for the foldback distortion.
+
+ FastMathApproximations::sin is only accurate on [-pi, pi], but at 200x drive the
+ argument runs into the hundreds. sinFold( ) first reduces the argument to
+ [-pi/2, pi/2] around the nearest multiple of pi (Cody-Waite, so n * pi stays exact
+ in float), flips the sign for odd multiples, then evaluates a degree 9 minimax
+ polynomial. Apart from one std::floor( ) it is straight-line arithmetic, where
+ std::sin( ) branches on the size of the argument and does a full range reduction.
+ */
+namespace FoldKernel
+{
+    /// sin(x) for any x up to a few thousand, max error a few 1e-6
+    inline float sinFold(float x)
+    {
+        // pi split into a short head (exact times any n < 2^16) and the remainder
+        constexpr float invPi = 0.318309886183790671f;
+        constexpr float piHi  = 3.140625f;
+        constexpr float piLo  = 9.67653589793e-4f;
+
+        // Minimax sin on [-pi/2, pi/2]
+        constexpr float s1 =  0.99999999997884898600f;
+        constexpr float s3 = -0.16666666608826069641f;
+        constexpr float s5 =  0.00833333072055773645f;
+        constexpr float s7 = -0.00019840832823261955f;
+        constexpr float s9 =  2.75239710746326498402e-6f;
+
+        float n = std::floor ( x * invPi + 0.5f );
+        float r = ( x - n * piHi ) - n * piLo;
+
+        // sin(r + n*pi) = (-1)^n * sin(r)
+        float sign = 1.0f - 2.0f * static_cast<float>( static_cast<int>( n ) & 1 );
+
+        float r2 = r * r;
+
+        return sign * r * ( s1 + r2 * ( s3 + r2 * ( s5 + r2 * ( s7 + r2 * s9 ) ) ) );
+    }
+}
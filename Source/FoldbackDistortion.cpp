@@ -11,7 +11,10 @@
 #include "FoldbackDistortion.h"
 
 FoldbackDistortion::FoldbackDistortion() :
-    dryWet ( std::make_unique<DryWet>() )
+    dryWet             ( std::make_unique<DryWet>() ),
+    useADAA            ( false ),
+    prevDriven         ( 0.0   ),
+    prevAntiderivative ( -1.0  )
 {}
 
 
@@ -20,54 +23,65 @@ FoldbackDistortion::~FoldbackDistortion() {}
 
 void FoldbackDistortion::setSampleRate(float SR)
 {
+    // reset( ) snaps to the target, so keep where the ramps are: an oversampling change mid-glide carries on gliding
+    float amountNow    = foldbackAmtSmooth.getCurrentValue();
+    float amountTarget = foldbackAmtSmooth.getTargetValue();
+    float dryWetNow    = dryWetSmooth.getCurrentValue();
+    float dryWetTarget = dryWetSmooth.getTargetValue();
+    
     foldbackAmtSmooth.reset ( SR, 0.01f );
     dryWetSmooth.reset      ( SR, 0.01f );
     
-    foldbackAmtSmooth.setTargetValue ( 0.0f );
-    dryWetSmooth.setTargetValue      ( 0.0f );
+    foldbackAmtSmooth.setCurrentAndTargetValue ( amountNow );
+    dryWetSmooth.setCurrentAndTargetValue      ( dryWetNow );
+    
+    foldbackAmtSmooth.setTargetValue ( amountTarget );
+    dryWetSmooth.setTargetValue      ( dryWetTarget );
 }
 
-juce::AudioBuffer<float> FoldbackDistortion::processFoldback(juce::AudioBuffer<float> &bufferIn, float foldbackAmount, float dryWetVal)
+bool FoldbackDistortion::prepareBlock(float foldbackAmount, float dryWetVal, int numSamples)
 {
-    auto* chanL = bufferIn.getWritePointer ( 0 );
-    auto* chanR = bufferIn.getWritePointer ( 1 );
-    
     foldbackAmtSmooth.setTargetValue ( foldbackAmount );
     dryWetSmooth.setTargetValue      ( dryWetVal      );
     
-    for (int sample = 0; sample < bufferIn.getNumSamples(); sample++)
+    // Fully dry: skip the stage, just keep the amount smoother in step
+    if (DryWet::isFullyDry ( dryWetSmooth ))
     {
-        float foldbackAmtSmoothVal = foldbackAmtSmooth.getNextValue();
-        float dryWetSmoothVal      = dryWetSmooth.getNextValue();
-        
-        float wetSampleL = juce::dsp::FastMathApproximations::sin( chanL[sample] * foldbackAmtSmoothVal );
-        float wetSampleR = juce::dsp::FastMathApproximations::sin( chanR[sample] * foldbackAmtSmoothVal );
-        
-        chanL[sample] = dryWet->dryWetMixEqualPowerBySample( chanL[sample], wetSampleL, dryWetSmoothVal );
-        chanR[sample] = dryWet->dryWetMixEqualPowerBySample( chanR[sample], wetSampleR, dryWetSmoothVal );
+        foldbackAmtSmooth.skip ( numSamples );
+        return false;
     }
     
-    return bufferIn;
+    return true;
 }
 
 
-void FoldbackDistortion::processFoldbackBuffer(juce::AudioBuffer<float> &bufferIn, float foldbackAmount, float dryWetVal)
+void FoldbackDistortion::setAntiAliasing(bool shouldUseADAA)
 {
-    auto* chanL = bufferIn.getWritePointer ( 0 );
-    auto* chanR = bufferIn.getWritePointer ( 1 );
+    if (shouldUseADAA == useADAA)
+        return;
     
-    foldbackAmtSmooth.setTargetValue ( foldbackAmount );
-    dryWetSmooth.setTargetValue      ( dryWetVal      );
+    useADAA            = shouldUseADAA;
+    prevDriven         = 0.0;
+    prevAntiderivative = -1.0;     // -cos(0)
+}
+
+
+/// First-order ADAA sine fold: (F(u) - F(uPrev)) / (u - uPrev), with F(u) = -cos(u)
+float FoldbackDistortion::processADAA(float driven)
+{
+    double u              = driven;
+    double antiderivative = -std::cos ( u );
+    double diff           = u - prevDriven;
+    double wetSample;
     
-    for (int sample = 0; sample < bufferIn.getNumSamples(); sample++)
-    {
-        float foldbackAmtSmoothVal = foldbackAmtSmooth.getNextValue();
-        float dryWetSmoothVal      = dryWetSmooth.getNextValue();
-        
-        float wetSampleL = juce::dsp::FastMathApproximations::sin( chanL[sample] * foldbackAmtSmoothVal );
-        float wetSampleR = juce::dsp::FastMathApproximations::sin( chanR[sample] * foldbackAmtSmoothVal );
-        
-        chanL[sample] = dryWet->dryWetMixEqualPowerBySample( chanL[sample], wetSampleL, dryWetSmoothVal );
-        chanR[sample] = dryWet->dryWetMixEqualPowerBySample( chanR[sample], wetSampleR, dryWetSmoothVal );
-    }
+    // Ill-conditioned when the input barely moved: fall back to sin at the midpoint
+    if (std::abs ( diff ) < 1.0e-5)
+        wetSample = std::sin ( 0.5 * ( u + prevDriven ) );
+    else
+        wetSample = ( antiderivative - prevAntiderivative ) / diff;
+    
+    prevDriven         = u;
+    prevAntiderivative = antiderivative;
+    
+    return static_cast<float>( wetSample );
 }
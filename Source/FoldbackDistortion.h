@@ -12,6 +12,7 @@
 
 #include <JuceHeader.h>
 #include "DryWet.h"
+#include "FoldKernel.h"
 
 class FoldbackDistortion
 {
@@ -21,16 +22,46 @@ public:
     
     void setSampleRate(float SR);
     
-    /// Returns an audio buffer of the dry/wet mixed Foldback signal
-    juce::AudioBuffer<float> processFoldback(juce::AudioBuffer<float>& bufferIn, float foldbackAmount, float dryWetVal);
+    /**
+     Sets the smoothing targets for the next numSamples samples. Returns false if the stage is fully dry,
+     in which case the smoothers are skipped ahead and processSample( ) must not be called for this block
+     */
+    bool prepareBlock(float foldbackAmount, float dryWetVal, int numSamples);
     
-    void processFoldbackBuffer(juce::AudioBuffer<float>& bufferIn, float foldbackAmount, float dryWetVal);
+    /// Folds back and dry/wet mixes a single sample. Call after prepareBlock( ) returned true
+    inline float processSample(float sampleIn);
+    
+    /**
+     Switches between the plain sine fold and first-order antiderivative anti-aliasing (ADAA).
+     The wet path lags the dry by half a sample in ADAA mode
+     */
+    void setAntiAliasing(bool shouldUseADAA);
     
 private:
+    /// First-order ADAA sine fold: (F(u) - F(uPrev)) / (u - uPrev), with F(u) = -cos(u)
+    float processADAA(float driven);
+    
     // DryWet class instance
     std::unique_ptr<DryWet> dryWet;
     
     // Member Variables
     juce::SmoothedValue<float> foldbackAmtSmooth;
     juce::SmoothedValue<float> dryWetSmooth;
+    
+    // ADAA state
+    bool   useADAA;
+    double prevDriven;
+    double prevAntiderivative;
 };
+
+
+inline float FoldbackDistortion::processSample(float sampleIn)
+{
+    float foldbackAmtSmoothVal = foldbackAmtSmooth.getNextValue();
+    float dryWetSmoothVal      = dryWetSmooth.getNextValue();
+    
+    float wetSample = useADAA ? processADAA ( sampleIn * foldbackAmtSmoothVal )
+                              : FoldKernel::sinFold ( sampleIn * foldbackAmtSmoothVal );
+    
+    return dryWet->mixEqualPower ( sampleIn, wetSample, dryWetSmoothVal );
+}
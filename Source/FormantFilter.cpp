@@ -12,7 +12,9 @@
 
 
 FormantFilter::FormantFilter() :
-    dryWet ( std::make_unique<DryWet>() )
+    controlInterval ( 16 ),
+    dryWet          ( std::make_unique<DryWet>() ),
+    isBypassed      ( false )
 {
     setQVals();
 }
@@ -28,9 +30,9 @@ void FormantFilter::prepare(juce::dsp::ProcessSpec &PS)
     filt2.prepare ( PS );
     filt3.prepare ( PS );
     
-    filt1.reset();
-    filt2.reset();
-    filt3.reset();
+    filt1.setControlInterval ( controlInterval );
+    filt2.setControlInterval ( controlInterval );
+    filt3.setControlInterval ( controlInterval );
     
     filt1.setType ( juce::dsp::StateVariableTPTFilterType::bandpass );
     filt2.setType ( juce::dsp::StateVariableTPTFilterType::bandpass );
@@ -53,23 +55,30 @@ void FormantFilter::prepare(juce::dsp::ProcessSpec &PS)
     
     dryWetSmooth.reset          ( PS.sampleRate, 0.01f );
     dryWetSmooth.setTargetValue ( 0.0f );
+    
+    // Summed formants, mixed against the dry signal a block at a time
+    wetBuffer.setSize ( 1, static_cast<int>( PS.maximumBlockSize ) );
+    wetBuffer.clear   ();
 }
 
 
-
-
-/**
-Takes the AudioBuffer, formant morph value (0.0f to 9.0f), and dry/wet (0.0 to 1.0f)
-and returns the formant filtered AudioBuffer
-*/
-juce::AudioBuffer<float> FormantFilter::process(juce::AudioBuffer<float> &buf, float morph, float dW)
+/// Sets the number of samples between formant coefficient updates
+void FormantFilter::setControlInterval(int numSamples)
 {
-    freqMorph ( morph );
+    controlInterval = juce::jmax ( 1, numSamples );
     
-    return filterAudio ( buf, dW );
+    filt1.setControlInterval ( controlInterval );
+    filt2.setControlInterval ( controlInterval );
+    filt3.setControlInterval ( controlInterval );
 }
 
 
+
+
+/**
+Takes the AudioBuffer, formant morph value (0.0f to 9.0f), and dry/wet (0.0 to 1.0f)
+and formant filters the AudioBuffer in place
+*/
 void FormantFilter::processBuffer(juce::AudioBuffer<float> &buf, float morph, float dW)
 {
     freqMorph         ( morph   );
@@ -79,18 +88,15 @@ void FormantFilter::processBuffer(juce::AudioBuffer<float> &buf, float morph, fl
 
 
 /// Applies filters to audio, sums filters, and blends with dryWet
-juce::AudioBuffer<float> FormantFilter::filterAudio(juce::AudioBuffer<float> &bufIn, float dryWet_)
+void FormantFilter::filterAudioBuffer(juce::AudioBuffer<float> &bufIn, float dryWet_)
 {
-    auto* leftChan  = bufIn.getWritePointer ( 0 );
-    auto* rightChan = bufIn.getWritePointer ( 1 );
+    int numSamples = bufIn.getNumSamples();
     
-    juce::AudioBuffer<float> f1;
-    juce::AudioBuffer<float> f2;
-    juce::AudioBuffer<float> f3;
+    // Hosts may send a bigger block than promised in prepare( ): grow to fit, keeping the allocation once it's there
+    wetBuffer.setSize ( 1, numSamples, false, false, true );
     
-    f1.makeCopyOf ( bufIn );
-    f2.makeCopyOf ( bufIn );
-    f3.makeCopyOf ( bufIn );
+    auto* monoChan = bufIn.getWritePointer ( 0 );
+    auto* wetChan  = wetBuffer.getWritePointer ( 0 );
     
     morphSmooth1.setTargetValue ( outFreqs[0] );
     morphSmooth2.setTargetValue ( outFreqs[1] );
@@ -101,103 +107,51 @@ juce::AudioBuffer<float> FormantFilter::filterAudio(juce::AudioBuffer<float> &bu
     
     dryWetSmooth.setTargetValue ( dryWet_ );
     
-    for (int sample = 0; sample < bufIn.getNumSamples(); sample++)
+    // Fully dry: skip the filters, keep the smoothers in step
+    if (DryWet::isFullyDry ( dryWetSmooth ))
     {
-        filt1.setCutoffFrequency ( morphSmooth1.getNextValue() );
-        filt2.setCutoffFrequency ( morphSmooth2.getNextValue() );
-        filt3.setCutoffFrequency ( morphSmooth3.getNextValue() );
-        filt1.setResonance       ( qSmooth1.getNextValue() );
-        filt2.setResonance       ( qSmooth2.getNextValue() );
-        filt3.setResonance       ( qSmooth3.getNextValue() );
-        
-        float smoothedDW = dryWetSmooth.getNextValue();
+        morphSmooth1.skip ( numSamples );
+        morphSmooth2.skip ( numSamples );
+        morphSmooth3.skip ( numSamples );
+        qSmooth1.skip     ( numSamples );
+        qSmooth2.skip     ( numSamples );
+        qSmooth3.skip     ( numSamples );
         
-        leftChan[sample] = dryWet->dryWetMixEqualPowerBySample ( leftChan[sample],
-                                                                 filt1.processSample ( 0, leftChan[sample] ),           //   0 dB
-                                                                 smoothedDW )
-                         + dryWet->dryWetMixEqualPowerBySample ( leftChan[sample],
-                                                                 filt2.processSample ( 0, leftChan[sample] ) * 0.178f,  // -15 dB
-                                                                 smoothedDW )
-                         + dryWet->dryWetMixEqualPowerBySample ( leftChan[sample],
-                                                                 filt3.processSample ( 0, leftChan[sample] ) * 0.355f,  //  -9 dB
-                                                                 smoothedDW );
-        
-        rightChan[sample] = dryWet->dryWetMixEqualPowerBySample ( rightChan[sample],
-                                                                  filt1.processSample ( 0, rightChan[sample] ),
-                                                                  smoothedDW )
-                          + dryWet->dryWetMixEqualPowerBySample ( rightChan[sample],
-                                                                  filt2.processSample ( 0, rightChan[sample] ) * 0.178f,
-                                                                  smoothedDW )
-                          + dryWet->dryWetMixEqualPowerBySample ( rightChan[sample],
-                                                                  filt2.processSample ( 0, rightChan[sample]) * 0.355f,
-                                                                  smoothedDW );
+        isBypassed = true;
+        return;
     }
     
-    filt1.snapToZero();
-    filt2.snapToZero();
-    filt3.snapToZero();
-    
-    return bufIn;
-}
-
-
-void FormantFilter::filterAudioBuffer(juce::AudioBuffer<float> &bufIn, float dryWet_)
-{
-    auto* leftChan  = bufIn.getWritePointer ( 0 );
-    auto* rightChan = bufIn.getWritePointer ( 1 );
-    
-    juce::AudioBuffer<float> f1;
-    juce::AudioBuffer<float> f2;
-    juce::AudioBuffer<float> f3;
-    
-    f1.makeCopyOf ( bufIn );
-    f2.makeCopyOf ( bufIn );
-    f3.makeCopyOf ( bufIn );
-    
-    morphSmooth1.setTargetValue ( outFreqs[0] );
-    morphSmooth2.setTargetValue ( outFreqs[1] );
-    morphSmooth3.setTargetValue ( outFreqs[2] );
-    qSmooth1.setTargetValue     ( outQVals[0] );
-    qSmooth2.setTargetValue     ( outQVals[1] );
-    qSmooth3.setTargetValue     ( outQVals[2] );
-    
-    dryWetSmooth.setTargetValue ( dryWet_ );
-    
-    for (int sample = 0; sample < bufIn.getNumSamples(); sample++)
+    // Coming back in: drop the stale filter state, the dry/wet ramp fades the filters in
+    if (isBypassed)
     {
-        filt1.setCutoffFrequency ( morphSmooth1.getNextValue() );
-        filt2.setCutoffFrequency ( morphSmooth2.getNextValue() );
-        filt3.setCutoffFrequency ( morphSmooth3.getNextValue() );
-        filt1.setResonance       ( qSmooth1.getNextValue() );
-        filt2.setResonance       ( qSmooth2.getNextValue() );
-        filt3.setResonance       ( qSmooth3.getNextValue() );
+        filt1.reset();
+        filt2.reset();
+        filt3.reset();
         
-        float smoothedDW = dryWetSmooth.getNextValue();
-        
-        leftChan[sample] = dryWet->dryWetMixEqualPowerBySample ( leftChan[sample],
-                                                                 filt1.processSample ( 0, leftChan[sample] ),           //   0 dB
-                                                                 smoothedDW )
-                         + dryWet->dryWetMixEqualPowerBySample ( leftChan[sample],
-                                                                 filt2.processSample ( 0, leftChan[sample] ) * 0.178f,  // -15 dB
-                                                                 smoothedDW )
-                         + dryWet->dryWetMixEqualPowerBySample ( leftChan[sample],
-                                                                 filt3.processSample ( 0, leftChan[sample] ) * 0.355f,  //  -9 dB
-                                                                 smoothedDW );
+        isBypassed = false;
+    }
+    
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        // Formant coefficients are updated at control rate and ramped in between
+        if (filt1.isUpdateDue())
+        {
+            filt1.setTargets ( morphSmooth1.skip ( controlInterval ), qSmooth1.skip ( controlInterval ) );
+            filt2.setTargets ( morphSmooth2.skip ( controlInterval ), qSmooth2.skip ( controlInterval ) );
+            filt3.setTargets ( morphSmooth3.skip ( controlInterval ), qSmooth3.skip ( controlInterval ) );
+        }
         
-        rightChan[sample] = dryWet->dryWetMixEqualPowerBySample ( rightChan[sample],
-                                                                  filt1.processSample ( 0, rightChan[sample] ),
-                                                                  smoothedDW )
-                          + dryWet->dryWetMixEqualPowerBySample ( rightChan[sample],
-                                                                  filt2.processSample ( 0, rightChan[sample] ) * 0.178f,
-                                                                  smoothedDW )
-                          + dryWet->dryWetMixEqualPowerBySample ( rightChan[sample],
-                                                                  filt2.processSample ( 0, rightChan[sample]) * 0.355f,
-                                                                  smoothedDW );
+        wetChan[sample] = filt1.processSample ( monoChan[sample] )              //   0 dB
+                        + filt2.processSample ( monoChan[sample] ) * 0.178f     // -15 dB
+                        + filt3.processSample ( monoChan[sample] ) * 0.355f;    //  -9 dB
     }
     
     filt1.snapToZero();
     filt2.snapToZero();
     filt3.snapToZero();
+    
+    // Each formant is blended with its own copy of the dry signal, hence the dry is scaled by 3
+    dryWet->dryWetMixEqualPowerBlock ( monoChan, wetChan, monoChan, numSamples, dryWetSmooth, 3.0f );
 }
 
 
@@ -12,6 +12,7 @@
 
 #include <JuceHeader.h>
 #include "DryWet.h"
+#include "ControlRateFilter.h"
 
 class FormantFilter
 {
@@ -24,12 +25,13 @@ public:
     
     /**
      Takes the AudioBuffer, formant morph value (0.0f to 9.0f), and dry/wet (0.0 to 1.0f)
-     and returns the formant filtered AudioBuffer
+     and formant filters the AudioBuffer in place
      */
-    juce::AudioBuffer<float> process(juce::AudioBuffer<float> &buf, float morph, float dW);
-    
     void processBuffer(juce::AudioBuffer<float> &buf, float morph, float dW);
     
+    /// Sets the number of samples between formant coefficient updates
+    void setControlInterval(int numSamples);
+    
     
 private:
     /// Morphs each formant frequency and Q to the next formant in the series.
@@ -42,15 +44,16 @@ private:
     void setQVals();
     
     /// Applies filters to audio, sums filters, and blends with dryWet
-    juce::AudioBuffer<float> filterAudio(juce::AudioBuffer<float> &bufIn, float dryWet_);
-    
     void filterAudioBuffer(juce::AudioBuffer<float> &bufIn, float dryWet_);
     
     
     // Filter Instances
-    juce::dsp::StateVariableTPTFilter<float> filt1;
-    juce::dsp::StateVariableTPTFilter<float> filt2;
-    juce::dsp::StateVariableTPTFilter<float> filt3;
+    ControlRateFilter filt1;
+    ControlRateFilter filt2;
+    ControlRateFilter filt3;
+    
+    /// Samples between formant coefficient updates
+    int controlInterval;
     
     std::unique_ptr<DryWet> dryWet;
     
@@ -62,6 +65,10 @@ private:
     juce::SmoothedValue<float> qSmooth2;
     juce::SmoothedValue<float> qSmooth3;
     juce::SmoothedValue<float> dryWetSmooth;
+    
+    juce::AudioBuffer<float> wetBuffer;
+    
+    bool isBypassed;
       
     // Formant Frequencies
     float ow[3] = {570.0f, 840.0f,  2410.0f};
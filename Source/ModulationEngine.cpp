@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    ModulationEngine.cpp
+    Created: 17 Oct 2026 8:15:22pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#include "ModulationEngine.h"
+
+namespace
+{
+    // Matches getControlRateNames( )
+    const int controlIntervals[] = { 16, 32, 64, 128, 256 };
+}
+
+ModulationEngine::ModulationEngine(juce::AudioProcessorValueTreeState& apvts) :
+    parameters         ( apvts   ),
+    numTargets         ( 0       ),
+    lfoValues          { 0.0f, 0.0f, 0.0f },
+    sampleRate         ( 44100.0 ),
+    controlInterval    ( 64      ),
+    samplesUntilUpdate ( 0       )
+{
+    sparseRateParam    = parameters.getRawParameterValue ( "sparseLFORate"    );
+    sparseWidthParam   = parameters.getRawParameterValue ( "sparseLFOWidth"   );
+    squareIORateParam  = parameters.getRawParameterValue ( "squareIOLFORate"  );
+    squareIOWidthParam = parameters.getRawParameterValue ( "squareIOLFOWidth" );
+    controlRateParam   = parameters.getRawParameterValue ( "modControlRate"   );
+    
+    lfoBank.setShape ( sparseLFOLane,   OscillatorBank::sparseShape   );
+    lfoBank.setShape ( squareIOLFOLane, OscillatorBank::squareIOShape );
+}
+
+ModulationEngine::~ModulationEngine() {}
+
+
+/// Source names in Source order, for the per-target source parameters
+juce::StringArray ModulationEngine::getSourceNames()
+{
+    return { "Off", "Sparse LFO", "Square I/O LFO" };
+}
+
+
+/// Control period choices (in samples) for the "modControlRate" parameter
+juce::StringArray ModulationEngine::getControlRateNames()
+{
+    return { "16", "32", "64", "128", "256" };
+}
+
+
+/// Registers a float parameter as a modulation target and returns its slot. Call before prepare( )
+int ModulationEngine::addTarget(const juce::String& paramID)
+{
+    jassert ( numTargets < maxTargets );
+    
+    auto& target = targets[numTargets];
+    
+    target.parameter = parameters.getParameter          ( paramID );
+    target.value     = parameters.getRawParameterValue ( paramID );
+    target.source    = parameters.getRawParameterValue ( paramID + "ModSource" );
+    target.depth     = parameters.getRawParameterValue ( paramID + "ModDepth"  );
+    target.offset    = parameters.getRawParameterValue ( paramID + "ModOffset" );
+    target.modulated = target.value->load();
+    
+    // The target and its three routing params must all exist
+    jassert ( target.parameter != nullptr && target.source != nullptr && target.depth != nullptr && target.offset != nullptr );
+    
+    return numTargets++;
+}
+
+
+/// Sets the sample rate and restarts the LFOs
+void ModulationEngine::prepare(double SR)
+{
+    sampleRate = SR;
+    
+    lfoBank.prepare ( sampleRate );
+    
+    samplesUntilUpdate = 0;
+}
+
+
+/// Advances the LFOs by numSamples and updates every target. Call at the start of each block
+void ModulationEngine::process(int numSamples)
+{
+    int newInterval = controlIntervals[juce::jlimit ( 0, 4, static_cast<int>( *controlRateParam ) )];
+    
+    if (newInterval != controlInterval)
+    {
+        controlInterval    = newInterval;
+        samplesUntilUpdate = 0;
+    }
+    
+    samplesUntilUpdate -= numSamples;
+    
+    if (samplesUntilUpdate > 0)
+        return;
+    
+    // Step the LFOs through every control period that ended in this block, in one go
+    updateRates();
+    
+    int numPeriods = 0;
+    
+    while (samplesUntilUpdate <= 0)
+    {
+        samplesUntilUpdate += controlInterval;
+        ++numPeriods;
+    }
+    
+    lfoBank.advance ( numPeriods * controlInterval );
+    
+    float laneOutputs[OscillatorBank::numLanes];
+    lfoBank.getOutputs ( laneOutputs );
+    
+    lfoValues[sparseLFOSource]   = laneOutputs[sparseLFOLane];
+    lfoValues[squareIOLFOSource] = laneOutputs[squareIOLFOLane];
+    
+    updateTargets();
+}
+
+
+/// Returns the modulated (plain) value of the target in slot
+float ModulationEngine::getValue(int slot) const
+{
+    jassert ( juce::isPositiveAndBelow ( slot, numTargets ) );
+    
+    const auto& target = targets[slot];
+    
+    // Unmodulated targets follow their parameter straight away
+    if (static_cast<int>( *target.source ) == noSource)
+        return *target.value;
+    
+    return target.modulated;
+}
+
+
+/// Computes the LFOs and every target's modulated value for the current control period
+void ModulationEngine::updateTargets()
+{
+    for (int slot = 0; slot < numTargets; slot++)
+    {
+        auto& target = targets[slot];
+        int   source = juce::jlimit ( 0, 2, static_cast<int>( *target.source ) );
+        
+        if (source == noSource)
+            continue;
+        
+        float normalised = target.parameter->convertTo0to1 ( *target.value );
+        normalised      += *target.offset + *target.depth * lfoValues[source];
+        
+        target.modulated = target.parameter->convertFrom0to1 ( juce::jlimit ( 0.0f, 1.0f, normalised ) );
+    }
+}
+
+
+/// Sets the LFO rates and pulse widths for the current control period
+void ModulationEngine::updateRates()
+{
+    lfoBank.setFrequency ( sparseLFOLane,   *sparseRateParam   );
+    lfoBank.setFrequency ( squareIOLFOLane, *squareIORateParam );
+    
+    lfoBank.setPulseWidth ( sparseLFOLane,   juce::jmax ( 0.01f, sparseWidthParam->load() ) );
+    lfoBank.setPulseWidth ( squareIOLFOLane, *squareIOWidthParam );
+}
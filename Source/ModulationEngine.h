@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    ModulationEngine.h
+    Created: 17 Oct 2026 8:15:22pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "OscillatorBank.h"
+
+/**
+ LFO modulation of APVTS parameters, run entirely on the audio thread.
+ 
+ Two LFOs (the sparse and square I/O lanes of an OscillatorBank) can be routed to any float parameter
+ registered with addTarget( ). Each target has its own source, depth and offset
+ parameters ("<paramID>ModSource", "<paramID>ModDepth", "<paramID>ModOffset"),
+ applied in the target's normalised 0-1 range so the modulation follows its skew.
+ 
+ The modulated value is only handed to the DSP through getValue( ): the parameter
+ itself is never written, so nothing goes through the host, the editor or the
+ message thread.
+ 
+ The LFOs and targets are updated once per control period (the "modControlRate"
+ parameter, in samples). Targets are read once per block, so periods shorter than
+ a block update at block rate.
+ */
+class ModulationEngine
+{
+public:
+    enum Source
+    {
+        noSource = 0,
+        sparseLFOSource,
+        squareIOLFOSource
+    };
+    
+    static constexpr int maxTargets = 8;
+    
+    explicit ModulationEngine(juce::AudioProcessorValueTreeState& apvts);
+    ~ModulationEngine();
+    
+    /// Source names in Source order, for the per-target source parameters
+    static juce::StringArray getSourceNames();
+    
+    /// Control period choices (in samples) for the "modControlRate" parameter
+    static juce::StringArray getControlRateNames();
+    
+    /// Registers a float parameter as a modulation target and returns its slot. Call before prepare( )
+    int addTarget(const juce::String& paramID);
+    
+    /// Sets the sample rate and restarts the LFOs
+    void prepare(double SR);
+    
+    /// Advances the LFOs by numSamples and updates every target. Call at the start of each block
+    void process(int numSamples);
+    
+    /// Returns the modulated (plain) value of the target in slot
+    float getValue(int slot) const;
+    
+private:
+    /// Computes the LFOs and every target's modulated value for the current control period
+    void updateTargets();
+    
+    /// Sets the LFO rates and pulse widths for the current control period
+    void updateRates();
+    
+    /// Bank lane of each LFO
+    enum Lane
+    {
+        sparseLFOLane = 0,
+        squareIOLFOLane
+    };
+    
+    struct Target
+    {
+        juce::RangedAudioParameter* parameter = nullptr;
+        std::atomic<float>*         value     = nullptr;
+        std::atomic<float>*         source    = nullptr;
+        std::atomic<float>*         depth     = nullptr;
+        std::atomic<float>*         offset    = nullptr;
+        float                       modulated = 0.0f;
+    };
+    
+    juce::AudioProcessorValueTreeState& parameters;
+    
+    Target targets[maxTargets];
+    int    numTargets;
+    
+    // LFOs are stepped a whole control period at a time and read once per period
+    OscillatorBank lfoBank;
+    float          lfoValues[3];
+    
+    double sampleRate;
+    int    controlInterval;
+    int    samplesUntilUpdate;
+    
+    // LFO and control rate params
+    std::atomic<float>* sparseRateParam;
+    std::atomic<float>* sparseWidthParam;
+    std::atomic<float>* squareIORateParam;
+    std::atomic<float>* squareIOWidthParam;
+    std::atomic<float>* controlRateParam;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModulationEngine)
+};
@@ -40,373 +40,699 @@
     Buttons: Adafruit 6MM Rainbow Tactile Button Delux. Completes circuit only
     while pressed. Each bank of buttons can attach to 1 pin on the Arduino, plus
     power & ground pins. 
+ 
+    Binary Frames: with USE_BINARY_FRAMES set the sketch sends one SensorFrame
+    datagram per loop to port 9002 instead of the OSC bundle to port 9001. See
+    SensorFrame.h for the layout.
 
   ==============================================================================
 */
 
 #include "OSCHandling.h"
 
-OSCHandler::OSCHandler() :
-    accelXAddress("/juce/accelX"),
-    accelYAddress("/juce/accelY"),
-    accelZAddress("/juce/accelZ"),
-
-    gyroXAddress("/juce/gyroX"),
-    gyroYAddress("/juce/gyroY"),
-    gyroZAddress("/juce/gyroZ"),
-
-    distanceAddress("/juce/dist"),
-
-    touchXAddress("/juce/touchX"),
-    touchYAddress("/juce/touchY"),
-    touchZAddress("/juce/touchZ"),
-
-    accelXOnOffAddress("/juce/accelXOnOff"),
-    accelYOnOffAddress("/juce/accelYOnOff"),
-    accelZOnOffAddress("/juce/accelZOnOff"),
+static_assert ( SensorFrame::numValues == OSCHandler::numSlots, "SensorFrame values must line up with OSCHandler::Slot" );
 
-    gyroXOnOffAddress("/juce/gyroXOnOff"),
-    gyroYOnOffAddress("/juce/gyroYOnOff"),
-    gyroZOnOffAddress("/juce/gyroZOnOff"),
+namespace
+{
+    // accel, gyro, distance and touch are interpolated by the jitter buffer; the switches and encoders after them are held
+    constexpr int numContinuousSlots = OSCHandler::touchZSlot + 1;
+    
+    /**
+     What the continuous sensors fade to once stale: the end of each mapping with the least
+     effect (lowest amounts, no delay), except touch, which goes to an open cutoff and low
+     resonance. Switches and encoders hold their last value
+     */
+    const float slotSafeValues[numContinuousSlots] =
+    {
+        -4.0f, -4.0f, -4.0f,            // accel
+        -2000.0f, -2000.0f, -2000.0f,   // gyro
+        0.0f,                           // distance
+        300.0f, 800.0f, 0.0f            // touch X (resonance), Y (cutoff), Z
+    };
+    
+    // Time a stale sensor takes to fade all the way to its safe value
+    constexpr double staleFadeMs = 250.0;
+    
+    // lastUpdate of a Slot nothing has been received for yet
+    constexpr double neverUpdated = -1.0;
+    
+    // A sequence jump bigger than this is the Arduino restarting, not lost frames
+    constexpr juce::int32 maxSequenceJump = 1000;
+    
+    // Addresses in Slot order
+    const char* const slotAddresses[OSCHandler::numSlots] =
+    {
+        "/juce/accelX",
+        "/juce/accelY",
+        "/juce/accelZ",
+        "/juce/gyroX",
+        "/juce/gyroY",
+        "/juce/gyroZ",
+        "/juce/dist",
+        "/juce/touchX",
+        "/juce/touchY",
+        "/juce/touchZ",
+        "/juce/accelXOnOff",
+        "/juce/accelYOnOff",
+        "/juce/accelZOnOff",
+        "/juce/gyroXOnOff",
+        "/juce/gyroYOnOff",
+        "/juce/gyroZOnOff",
+        "/juce/touchScreenXOnOff",
+        "/juce/touchScreenYOnOff",
+        "/juce/touchScreenZOnOff",
+        "/juce/distanceOnOff",
+        "/juce/filtType",
+        "/juce/filtPole",
+        "/juce/encoder1",
+        "/juce/encoder2",
+        "/juce/encButton1",
+        "/juce/encButton2"
+    };
+    
+    // Values before the Arduino sends anything
+    const float slotDefaults[OSCHandler::numSlots] =
+    {
+        0.0f, 0.0f, 0.0f,           // accel
+        0.0f, 0.0f, 0.0f,           // gyro
+        0.0f,                       // distance
+        0.0f, 0.0f, 0.0f,           // touch
+        -1.0f, -1.0f, -1.0f,        // accel on/off
+        -1.0f, -1.0f, -1.0f,        // gyro on/off
+        -1.0f, -1.0f, -1.0f,        // touch on/off
+        -1.0f,                      // distance on/off
+        0.0f, -1.0f,                // filter type, pole
+        0.0f, 0.0f, 0.0f, 0.0f      // encoders, encoder buttons
+    };
+    
+    /// FNV-1a over the address characters
+    juce::uint32 hashAddress(juce::String::CharPointerType address)
+    {
+        juce::uint32 hash = 2166136261u;
+        
+        while (! address.isEmpty())
+        {
+            hash ^= static_cast<juce::uint32>( address.getAndAdvance() );
+            hash *= 16777619u;
+        }
+        
+        return hash;
+    }
+    
+    /**
+     Open-addressed hash table from address hash to Slot, built once. A lookup is one hash
+     of the incoming address, usually one probe, and one string compare to confirm the match
+     */
+    struct DispatchTable
+    {
+        static constexpr int size = 64;     // power of two, over twice numSlots
+        
+        DispatchTable()
+        {
+            std::fill ( std::begin ( entries ), std::end ( entries ), -1 );
+            
+            for (int slot = 0; slot < OSCHandler::numSlots; slot++)
+            {
+                hashes[slot] = hashAddress ( juce::String ( slotAddresses[slot] ).getCharPointer() );
+                
+                int index = static_cast<int>( hashes[slot] & ( size - 1 ) );
+                
+                while (entries[index] >= 0)
+                    index = ( index + 1 ) & ( size - 1 );
+                
+                entries[index] = slot;
+            }
+        }
+        
+        int          entries[size];
+        juce::uint32 hashes[OSCHandler::numSlots];
+    };
+    
+    const DispatchTable& getDispatchTable()
+    {
+        static const DispatchTable table;
+        return table;
+    }
+}
 
-    touchXOnOffAddress("/juce/touchScreenXOnOff"),
-    touchYOnOffAddress("/juce/touchScreenYOnOff"),
-    touchZOnOffAddress("/juce/touchScreenZOnOff"),
 
-    distanceOnOffAddress("/juce/distanceOnOff"),
+OSCHandler::OSCHandler() :
+    frameReceiver      ( std::make_unique<FrameReceiver>( *this ) ),
+    oscPortOpen        ( false ),
+    framePortOpen      ( false ),
+    receivedButtons    ( 0 ),
+    jitterBuffer       ( std::make_unique<SensorJitterBuffer>( numSlots, numContinuousSlots ) ),
+    lastFrameArrivalMs ( neverUpdated ),
+    hasFrameSequence   ( false  ),
+    expectedSequence   ( 0      ),
+    recentSequences    ( 0      ),
+    staleTimeout       ( 500.0f )
+{
+    std::copy ( std::begin ( slotDefaults ), std::end ( slotDefaults ), received );
+    
+    for (int slot = 0; slot < numSlots; slot++)
+    {
+        published[slot].store  ( slotDefaults[slot], std::memory_order_relaxed );
+        lastUpdate[slot].store ( neverUpdated,       std::memory_order_relaxed );
+    }
+    
+    // Build the dispatch table here rather than on the first message
+    getDispatchTable();
+    
+    // UDP Socket Port. Fails if another instance (or another app) already has it
+    oscPortOpen = connect ( 9001 );
+    
+    // Messages and bundles. No per-address listeners: those would handle every message a second time
+    addListener ( this );
+    
+    // Binary frames. Without the socket there's nothing for the frame thread to wait on, so it isn't started
+    framePortOpen = frameSocket.bindToPort ( 9002 );
+    
+    if (framePortOpen)
+        frameReceiver->startThread ( 8 );
+}
 
-    filterTypeAddress("/juce/filtType"),
-    filterPoleAddress("/juce/filtPole"),
 
-    encoder1Address("/juce/encoder1"),
-    encoder2Address("/juce/encoder2"),
+OSCHandler::~OSCHandler()
+{
+    // Stop both receiver threads before the values they write go away
+    frameReceiver->signalThreadShouldExit();
+    frameSocket.shutdown();
+    frameReceiver->stopThread ( 1000 );
+    
+    disconnect();
+    removeListener ( this );
+}
 
-    encButton1Address("/juce/encButton1"),
-    encButton2Address("/juce/encButton2"),
 
-    accelXVal(0.0f),
-    accelYVal(0.0f),
-    accelZVal(0.0f),
+/**
+ Copies out the latest published Snapshot. Lock-free and safe from any thread, including the
+ audio thread: retries (without blocking) only if an update is being published mid-copy
+ */
+OSCHandler::Snapshot OSCHandler::getSnapshot() const
+{
+    Snapshot snapshot;
     
-    gyroXVal(0.0f),
-    gyroYVal(0.0f),
-    gyroZVal(0.0f),
-
-    distVal(0.0f),
+    for (;;)
+    {
+        juce::uint32 before = sequence.load ( std::memory_order_acquire );
+        
+        if (( before & 1 ) == 0)
+        {
+            for (int slot = 0; slot < numSlots; slot++)
+                snapshot.values[slot] = published[slot].load ( std::memory_order_relaxed );
+            
+            snapshot.buttonMask = publishedButtons.load ( std::memory_order_relaxed );
+            
+            std::atomic_thread_fence ( std::memory_order_acquire );
+            
+            if (sequence.load ( std::memory_order_relaxed ) == before)
+            {
+                snapshot.version = before / 2;
+                return snapshot;
+            }
+        }
+    }
+}
 
-    touchXVal(0.0f),
-    touchYVal(0.0f),
-    touchZVal(0.0f),
 
-    accelXOnOff(-1.0f),
-    accelYOnOff(-1.0f),
-    accelZOnOff(-1.0f),
+/**
+ Like getSnapshot( ), but the values are the ones at timeMs (Time::getMillisecondCounterHiRes( ))
+ minus the buffer delay, with the continuous sensors interpolated between updates
+ */
+OSCHandler::Snapshot OSCHandler::getBufferedSnapshot(double timeMs) const
+{
+    Snapshot snapshot = getSnapshot();
+    
+    // Nothing buffered yet: the defaults from getSnapshot( ) stand
+    jitterBuffer->read ( timeMs, snapshot.values );
+    
+    // Fade sensors that have stopped updating towards their safe values. One that never started keeps its default
+    double timeout = staleTimeout.load ( std::memory_order_relaxed );
+    
+    for (int slot = 0; slot < numContinuousSlots; slot++)
+    {
+        double slotTime = lastUpdate[slot].load ( std::memory_order_relaxed );
+        
+        if (slotTime == neverUpdated)
+            continue;
+        
+        double age  = timeMs - slotTime;
+        float  fade = static_cast<float>( juce::jlimit ( 0.0, 1.0, ( age - timeout ) / staleFadeMs ) );
+        
+        snapshot.values[slot] += fade * ( slotSafeValues[slot] - snapshot.values[slot] );
+    }
     
-    gyroXOnOff(-1.0f),
-    gyroYOnOff(-1.0f),
-    gyroZOnOff(-1.0f),
+    return snapshot;
+}
 
-    touchXOnOff(-1.0f),
-    touchYOnOff(-1.0f),
-    touchZOnOff(-1.0f),
 
-    distanceOnOff(-1.0f),
+/// Sets how far getBufferedSnapshot( ) reads behind real time, in ms: latency traded for smoothness
+void OSCHandler::setBufferDelay(float delayMs)
+{
+    jitterBuffer->setDelay ( delayMs );
+}
+
 
-    filtType(0.0f),
-    filtPole(-1.0f),
+/// Sets how long a sensor can go without an update before getBufferedSnapshot( ) fades it to its safe value, in ms
+void OSCHandler::setStaleTimeout(float timeoutMs)
+{
+    staleTimeout.store ( juce::jmax ( 0.0f, timeoutMs ), std::memory_order_relaxed );
+}
 
-    encoder1(0.0f),
-    encoder2(0.0f),
-    encButton1(0.0f),
-    encButton2(0.0f)
 
+/// Returns the link statistics as of timeMs (Time::getMillisecondCounterHiRes( )). Safe from any thread
+OSCHandler::LinkStats OSCHandler::getLinkStats(double timeMs) const
 {
-    // UDP Socket Port
-    connect ( 9001 );
+    LinkStats stats;
     
-    // Bundle
-    addListener ( this );
+    stats.framesReceived   = framesReceived.load   ( std::memory_order_relaxed );
+    stats.framesLost       = framesLost.load       ( std::memory_order_relaxed );
+    stats.framesReordered  = framesReordered.load  ( std::memory_order_relaxed );
+    stats.framesLate       = framesLate.load       ( std::memory_order_relaxed );
+    stats.framesDuplicated = framesDuplicated.load ( std::memory_order_relaxed );
+    stats.oscPortOpen      = oscPortOpen;
+    stats.framePortOpen    = framePortOpen;
     
-    // Messages
-    addListener ( this, accelXAddress   );
-    addListener ( this, accelYAddress   );
-    addListener ( this, accelZAddress   );
+    double timeout = staleTimeout.load ( std::memory_order_relaxed );
+    double newest  = neverUpdated;
     
-    addListener ( this, gyroXAddress    );
-    addListener ( this, gyroYAddress    );
-    addListener ( this, gyroZAddress    );
+    for (int slot = 0; slot < numSlots; slot++)
+    {
+        double slotTime = lastUpdate[slot].load ( std::memory_order_relaxed );
+        
+        if (slotTime == neverUpdated)
+            continue;
+        
+        newest = juce::jmax ( newest, slotTime );
+        
+        if (timeMs - slotTime > timeout)
+            stats.staleSlots |= 1u << slot;
+    }
+    
+    stats.hasReceived   = newest != neverUpdated;
+    stats.msSinceUpdate = stats.hasReceived ? timeMs - newest : 0.0;
     
-    addListener ( this, touchXAddress   );
-    addListener ( this, touchYAddress   );
-    addListener ( this, touchZAddress   );
+    return stats;
+}
+
+
+/// Zeroes the frame counters
+void OSCHandler::resetLinkStats()
+{
+    framesReceived.store   ( 0, std::memory_order_relaxed );
+    framesLost.store       ( 0, std::memory_order_relaxed );
+    framesReordered.store  ( 0, std::memory_order_relaxed );
+    framesLate.store       ( 0, std::memory_order_relaxed );
+    framesDuplicated.store ( 0, std::memory_order_relaxed );
+}
+
+
+/// Returns the last value received for a Slot. Use getSnapshot( ) when several values need to match
+float OSCHandler::getValue(int slot) const
+{
+    jassert ( juce::isPositiveAndBelow ( slot, static_cast<int>( numSlots ) ) );
     
-    addListener ( this, distanceAddress );
+    return published[slot].load ( std::memory_order_relaxed );
+}
+
+
+/// Returns the slot for an OSC address, or -1 if it isn't one of ours. Doesn't allocate
+int OSCHandler::findSlot(const juce::String& address)
+{
+    const auto&  table = getDispatchTable();
+    juce::uint32 hash  = hashAddress ( address.getCharPointer() );
     
-    addListener( this, accelXOnOffAddress );
-    addListener( this, accelYOnOffAddress );
-    addListener( this, accelZOnOffAddress );
+    for (int probe = 0; probe < DispatchTable::size; probe++)
+    {
+        int slot = table.entries[( hash + probe ) & ( DispatchTable::size - 1 )];
+        
+        if (slot < 0)
+            return -1;
+        
+        if (table.hashes[slot] == hash && address == slotAddresses[slot])
+            return slot;
+    }
     
-    addListener( this, gyroXOnOffAddress );
-    addListener( this, gyroYOnOffAddress );
-    addListener( this, gyroZOnOffAddress );
+    return -1;
+}
+
+
+/**
+ Automatically called when OSC Bundle comes in, stores every message in it (and in any nested
+ bundles), then publishes once so the whole bundle shows up in the same Snapshot
+ */
+void OSCHandler::oscBundleReceived(const juce::OSCBundle &bundle)
+{
+    double arrivalMs = juce::Time::getMillisecondCounterHiRes();
     
-    addListener( this, touchXOnOffAddress );
-    addListener( this, touchYOnOffAddress );
-    addListener( this, touchZOnOffAddress );
+    const juce::SpinLock::ScopedLockType lock ( writerLock );
     
-    addListener( this, distanceOnOffAddress );
+    storeBundle ( bundle, arrivalMs );
+    publish     ( arrivalMs, ! isFrameLinkActive ( arrivalMs ) );
+}
+
+
+/// Called on the OSC receiver thread when an OSC Message comes in. Stores the incoming float and publishes it
+void OSCHandler::oscMessageReceived(const juce::OSCMessage &message)
+{
+    double arrivalMs = juce::Time::getMillisecondCounterHiRes();
     
-    addListener( this, filterTypeAddress );
-    addListener( this, filterPoleAddress );
+    const juce::SpinLock::ScopedLockType lock ( writerLock );
     
-    addListener( this, encoder1Address   );
-    addListener( this, encoder2Address   );
-    addListener( this, encButton1Address );
-    addListener( this, encButton2Address );
+    storeMessage ( message, arrivalMs );
+    publish      ( arrivalMs, ! isFrameLinkActive ( arrivalMs ) );
 }
 
 
-OSCHandler::~OSCHandler()
-{}
+/// Runs on the FrameReceiver: waits on the frame socket and decodes each datagram in place
+void OSCHandler::receiveFrames()
+{
+    while (! frameReceiver->threadShouldExit())
+    {
+        // Time out now and then to check threadShouldExit( )
+        int ready = frameSocket.waitUntilReady ( true, 100 );
+        
+        if (ready < 0)
+            break;
+        
+        if (ready == 0)
+            continue;
+        
+        int    numBytes  = frameSocket.read ( frameBuffer, sizeof ( frameBuffer ), false );
+        double arrivalMs = juce::Time::getMillisecondCounterHiRes();
+        
+        SensorFrame::View frame ( frameBuffer, numBytes );
+        
+        if (! frame.isValid())
+            continue;
+        
+        const juce::SpinLock::ScopedLockType lock ( writerLock );
+        
+        // A device clock jump means the Arduino may have rebooted, restarting its sequence numbers too
+        bool deviceClockJumped = jitterBuffer->isDeviceClockJump ( frame.getTimestamp() );
+        
+        // Duplicates and frames older than the newest seen are counted, but would only overwrite newer values
+        if (! trackSequence ( frame.getSequence(), deviceClockJumped ))
+            continue;
+        
+        storeFrame ( frame, arrivalMs );
+        
+        lastFrameArrivalMs = arrivalMs;
+        
+        // Time the frame by when the Arduino sent it, not when WiFi delivered it
+        double frameMs = jitterBuffer->deviceToHostTime ( frame.getTimestamp(), arrivalMs );
+        
+        // Later than the buffer delay allows for: the buffer had already played past it
+        if (arrivalMs - frameMs > jitterBuffer->getDelay())
+            framesLate.fetch_add ( 1, std::memory_order_relaxed );
+        
+        publish ( frameMs, true );
+    }
+}
 
 
-/**
- Automatically called when OSC Bundle comes in, splits bundle into its elements, and calls either
- oscMessageReceived or oscBundleReceived depending on which type the element of the bundle is
- */
-void OSCHandler::oscBundleReceived(const juce::OSCBundle &bundle)
+/// Stores every message in a bundle, and in any bundles nested in it
+void OSCHandler::storeBundle(const juce::OSCBundle &bundle, double arrivalMs)
 {
-    if (bundle.size() > 0)
+    for (const auto& elem : bundle)
     {
-        for (int i = 0; i < bundle.size(); i++)
-        {
-            auto elem = bundle[i];
-            
-            if (elem.isMessage())
-                oscMessageReceived ( elem.getMessage() );
-            else if (elem.isBundle())
-                oscBundleReceived ( elem.getBundle() );
-        }
+        if (elem.isMessage())
+            storeMessage ( elem.getMessage(), arrivalMs );
+        else if (elem.isBundle())
+            storeBundle ( elem.getBundle(), arrivalMs );
     }
 }
 
 
-void OSCHandler::oscMessageReceived(const juce::OSCMessage &message)
+/// Looks up the address slot and stores the incoming float in the receiver's working copy
+void OSCHandler::storeMessage(const juce::OSCMessage &message, double arrivalMs)
+{
+    if (message.isEmpty() || ! message[0].isFloat32())
+        return;
+    
+    // toString( ) hands back the pattern's own (ref-counted) string: no copy of the characters
+    int slot = findSlot ( message.getAddressPattern().toString() );
+    
+    if (slot >= 0)
+    {
+        received[slot] = message[0].getFloat32();
+        lastUpdate[slot].store ( arrivalMs, std::memory_order_relaxed );
+    }
+}
+
+
+/// Copies a valid frame's values and buttons into the working copy
+void OSCHandler::storeFrame(const SensorFrame::View &frame, double arrivalMs)
 {
-    juce::String address = message.getAddressPattern().toString();
+    for (int slot = 0; slot < numSlots; slot++)
+    {
+        received[slot] = frame.getValue ( slot );
+        lastUpdate[slot].store ( arrivalMs, std::memory_order_relaxed );
+    }
+    
+    receivedButtons = frame.getButtonMask();
+}
+
+
+/**
+ Counts lost, reordered and duplicated frames from a frame's sequence number. Returns true if
+ the frame is the newest seen, false if it's older or a repeat. deviceClockJumped re-anchors on
+ a sequence that went backwards: the Arduino rebooted. Call with writerLock held
+ */
+bool OSCHandler::trackSequence(juce::uint32 frameSequence, bool deviceClockJumped)
+{
+    framesReceived.fetch_add ( 1, std::memory_order_relaxed );
+    
+    // Signed, so the counter wrapping doesn't matter
+    auto gap = static_cast<juce::int32>( frameSequence - expectedSequence );
+    
+    // A forward jump with the clock is a dropout, so its frames still count as lost
+    if (! hasFrameSequence || std::abs ( gap ) > maxSequenceJump || ( deviceClockJumped && gap < 0 ))
+    {
+        hasFrameSequence = true;
+        expectedSequence = frameSequence + 1;
+        recentSequences  = 1;
+        return true;
+    }
     
-    if (message[0].isFloat32())
+    if (gap >= 0)
     {
-        float val = message[0].getFloat32();
+        framesLost.fetch_add ( static_cast<juce::uint32>( gap ), std::memory_order_relaxed );
+        expectedSequence = frameSequence + 1;
         
-        if (address == accelXAddress.toString())
-            accelXVal = val;
-        else if (address == accelYAddress.toString())
-            accelYVal = val;
-        else if (address == accelZAddress.toString())
-            accelZVal = val;
-        else if (address == gyroXAddress.toString())
-            gyroXVal = val;
-        else if (address == gyroYAddress.toString())
-            gyroYVal = val;
-        else if (address == gyroZAddress.toString())
-            gyroZVal = val;
-        else if (address == touchXAddress.toString())
-            touchXVal = val;
-        else if (address == touchYAddress.toString())
-            touchYVal = val;
-        else if (address == touchZAddress.toString())
-            touchZVal = val;
-        else if (address == distanceAddress.toString())
-            distVal = val;
-        else if (address == accelXOnOffAddress.toString())
-            accelXOnOff = val;
-        else if (address == accelYOnOffAddress.toString())
-            accelYOnOff = val;
-        else if (address == accelZOnOffAddress.toString())
-            accelZOnOff = val;
-        else if (address == gyroXOnOffAddress.toString())
-            gyroXOnOff = val;
-        else if (address == gyroYOnOffAddress.toString())
-            gyroYOnOff = val;
-        else if (address == gyroZOnOffAddress.toString())
-            gyroZOnOff = val;
-        else if (address == touchXOnOffAddress.toString())
-            touchXOnOff = val;
-        else if (address == touchYOnOffAddress.toString())
-            touchYOnOff = val;
-        else if (address == touchZOnOffAddress.toString())
-            touchZOnOff = val;
-        else if (address == distanceOnOffAddress.toString())
-            distanceOnOff = val;
-        else if (address == filterTypeAddress.toString())
-            filtType = val;
-        else if (address == filterPoleAddress.toString())
-            filtPole = val;
-        else if (address == encoder1Address.toString())
-            encoder1 = val;
-        else if (address == encoder2Address.toString())
-            encoder2 = val;
-        else if (address == encButton1Address.toString())
-            encButton1 = val;
-        else if (address == encButton2Address.toString())
-            encButton2 = val;
+        // Bit n of recentSequences is the frame n behind the newest
+        recentSequences = gap + 1 < 64 ? ( recentSequences << ( gap + 1 ) ) | 1 : 1;
+        return true;
     }
+    
+    int  age        = -gap - 1;     // 0 = the newest frame again
+    bool inWindow   = age < 64;
+    bool seenBefore = inWindow && ( ( recentSequences >> age ) & 1 ) != 0;
+    
+    if (seenBefore)
+    {
+        framesDuplicated.fetch_add ( 1, std::memory_order_relaxed );
+        return false;
+    }
+    
+    if (inWindow)
+        recentSequences |= juce::uint64 ( 1 ) << age;
+    
+    // Counted as lost when the gap opened, but it turned up after all
+    framesReordered.fetch_add ( 1, std::memory_order_relaxed );
+    
+    if (framesLost.load ( std::memory_order_relaxed ) > 0)
+        framesLost.fetch_sub ( 1, std::memory_order_relaxed );
+    
+    return false;
+}
+
+
+/**
+ Publishes the working copy as the next Snapshot (seqlock write), and into the jitter buffer
+ stamped timeMs if buffered is true. Call with writerLock held
+ */
+void OSCHandler::publish(double timeMs, bool buffered)
+{
+    juce::uint32 current = sequence.load ( std::memory_order_relaxed );
+    
+    // Odd while writing, so readers know to retry
+    sequence.store ( current + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence ( std::memory_order_release );
+    
+    for (int slot = 0; slot < numSlots; slot++)
+        published[slot].store ( received[slot], std::memory_order_relaxed );
+    
+    publishedButtons.store ( receivedButtons, std::memory_order_relaxed );
+    
+    sequence.store ( current + 2, std::memory_order_release );
+    
+    if (buffered)
+        jitterBuffer->push ( received, timeMs );
+}
+
+
+/// Returns true if a binary frame has arrived within the stale timeout. Call with writerLock held
+bool OSCHandler::isFrameLinkActive(double timeMs) const
+{
+    return lastFrameArrivalMs != neverUpdated
+        && timeMs - lastFrameArrivalMs <= staleTimeout.load ( std::memory_order_relaxed );
 }
 
 
 /// Returns float value of Accelerometer X Axis
 float OSCHandler::getAccelX()
 {
-    return accelXVal;
+    return getValue ( accelXSlot );
 }
 
 /// Returns float value of Accelerometer Y Axis
 float OSCHandler::getAccelY()
 {
-    return accelYVal;
+    return getValue ( accelYSlot );
 }
 
 /// Returns float value of Accelerometer Z Axis
 float OSCHandler::getAccelZ()
 {
-    return accelZVal;
+    return getValue ( accelZSlot );
 }
 
 /// Returns float value of Gyroscope X Axis
 float OSCHandler::getGyroX()
 {
-    return gyroXVal;
+    return getValue ( gyroXSlot );
 }
 
 /// Returns float value of Gyroscope Y Axis
 float OSCHandler::getGyroY()
 {
-    return gyroYVal;
+    return getValue ( gyroYSlot );
 }
 
 /// Returns float value of Gyroscope Z Axis
 float OSCHandler::getGyroZ()
 {
-    return gyroZVal;
+    return getValue ( gyroZSlot );
 }
 
 /// Returns float value of Distance Meter
 float OSCHandler::getDistance()
 {
-    return distVal;
+    return getValue ( distanceSlot );
 }
 
 /// Returns float value of Toucscreen X Axis
 float OSCHandler::getTouchX()
 {
-    return touchXVal;
+    return getValue ( touchXSlot );
 }
 
 /// Returns float value of Touchscreen Y Axis
 float OSCHandler::getTouchY()
 {
-    return touchYVal;
+    return getValue ( touchYSlot );
 }
 
 /// Returns float value of Touchscreen Z Axis (Pressure)
 float OSCHandler::getTouchZ()
 {
-    return touchZVal;
+    return getValue ( touchZSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getAccelXOnOff()
 {
-    return accelXOnOff;
+    return getValue ( accelXOnOffSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getAccelYOnOff()
 {
-    return accelYOnOff;
+    return getValue ( accelYOnOffSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getAccelZOnOff()
 {
-    return accelZOnOff;
+    return getValue ( accelZOnOffSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getGyroXOnOff()
 {
-    return gyroXOnOff;
+    return getValue ( gyroXOnOffSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getGyroYOnOff()
 {
-    return gyroYOnOff;
+    return getValue ( gyroYOnOffSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getGyroZOnOff()
 {
-    return gyroZOnOff;
+    return getValue ( gyroZOnOffSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getTouchXOnOff()
 {
-    return touchXOnOff;
+    return getValue ( touchXOnOffSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getTouchYOnOff()
 {
-    return touchYOnOff;
+    return getValue ( touchYOnOffSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getTouchZOnOff()
 {
-    return touchZOnOff;
+    return getValue ( touchZOnOffSlot );
 }
 
 /// Returns 0 or 1 if this sensor is Off or On respectively
 float OSCHandler::getDistanceOnOff()
 {
-    return distanceOnOff;
+    return getValue ( distanceOnOffSlot );
 }
 
 /// Returns rotational value of encoder1
 float OSCHandler::getEncoder1()
 {
-    return encoder1;
+    return getValue ( encoder1Slot );
 }
 
 /// Returns rotational value of encoder2
 float OSCHandler::getEncoder2()
 {
-    return encoder2;
+    return getValue ( encoder2Slot );
 }
 
 /// Returns encButton1 value 0 to 6
 float OSCHandler::getEncButton1()
 {
-    return encButton1;
+    return getValue ( encButton1Slot );
 }
 
 /// Returns encButton2 value 0 to 2
 float OSCHandler::getEncButton2()
 {
-    return encButton2;
+    return getValue ( encButton2Slot );
 }
 
 /// Returns filter type 0 = LPF; 1 = BPF; 2 = HPF
 float OSCHandler::getFiltType()
 {
-    return filtType;
+    return getValue ( filterTypeSlot );
 }
 
 /// Returns filter pole value -1 or 1
 float OSCHandler::getFiltPole()
 {
-    return filtPole;
+    return getValue ( filterPoleSlot );
 }
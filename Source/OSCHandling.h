@@ -33,15 +33,128 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "SensorFrame.h"
+#include "SensorJitterBuffer.h"
 
+/**
+ Receives the Arduino's sensor and button values, either as OSC (UDP port 9001) or as
+ binary SensorFrames (UDP port 9002). The sketch sends one or the other (USE_BINARY_FRAMES).
+ If both do arrive, getSnapshot( ) takes the last update of either, but the jitter buffer
+ only follows the frames: OSC updates are timed by arrival and frames by the Arduino's clock,
+ and one buffer can't hold both in order.
+
+ Messages are handled on the OSC receiver's own thread, not the message thread, so
+ they never queue behind GUI painting, and frames on a thread of their own. Every update
+ is published as a Snapshot through a seqlock: readers on any thread (audio or GUI) copy
+ a consistent frame without locks.
+
+ Updates also go through a SensorJitterBuffer: getBufferedSnapshot( ) reads the sensors a
+ set delay in the past, interpolated between updates, so WiFi jitter doesn't step them.
+
+ The link is watched too: binary frame sequence numbers give lost, reordered and late
+ counts (getLinkStats( )), and a sensor that hasn't been updated for the stale timeout
+ fades to a safe value in getBufferedSnapshot( ), so a dropout can't leave a mapped
+ parameter stuck wherever it was. A port that couldn't be opened (another instance of the
+ plugin already has it) shows up in getLinkStats( ) too.
+ */
 class OSCHandler : private juce::OSCReceiver,
-                   private juce::OSCReceiver::ListenerWithOSCAddress<juce::OSCReceiver::MessageLoopCallback>,
-                   private juce::OSCReceiver::Listener<juce::OSCReceiver::MessageLoopCallback>
+                   private juce::OSCReceiver::Listener<juce::OSCReceiver::RealtimeCallback>
 {
 public:
+    /// One slot per OSC address the Arduino sends
+    enum Slot
+    {
+        accelXSlot = 0,
+        accelYSlot,
+        accelZSlot,
+        gyroXSlot,
+        gyroYSlot,
+        gyroZSlot,
+        distanceSlot,
+        touchXSlot,
+        touchYSlot,
+        touchZSlot,
+        accelXOnOffSlot,
+        accelYOnOffSlot,
+        accelZOnOffSlot,
+        gyroXOnOffSlot,
+        gyroYOnOffSlot,
+        gyroZOnOffSlot,
+        touchXOnOffSlot,
+        touchYOnOffSlot,
+        touchZOnOffSlot,
+        distanceOnOffSlot,
+        filterTypeSlot,
+        filterPoleSlot,
+        encoder1Slot,
+        encoder2Slot,
+        encButton1Slot,
+        encButton2Slot,
+        numSlots
+    };
+    
+    /// Every sensor and button value from one published update
+    struct Snapshot
+    {
+        /// Returns the value of a Slot
+        float get(int slot) const   { return values[slot]; }
+        
+        /// Returns true while a button is held, see SensorFrame for the bit order. Binary frames only
+        bool isButtonHeld(int button) const   { return ( buttonMask >> button ) & 1; }
+        
+        float        values[numSlots];
+        juce::uint32 buttonMask = 0;
+        juce::uint32 version    = 0;    // Counts published updates, 0 = nothing received yet
+    };
+    
+    /// Health of the link to the Arduino
+    struct LinkStats
+    {
+        juce::uint32 framesReceived   = 0;       // Binary frames received
+        juce::uint32 framesLost       = 0;       // Sequence numbers skipped and never seen
+        juce::uint32 framesReordered  = 0;       // Frames that arrived after a later one
+        juce::uint32 framesLate       = 0;       // Frames delayed by more than the buffer delay
+        juce::uint32 framesDuplicated = 0;       // Frames whose sequence number had already arrived
+        bool         hasReceived      = false;   // False until the first update of any kind
+        double       msSinceUpdate    = 0.0;     // Since the last update of any kind, OSC or binary. 0 until hasReceived
+        juce::uint32 staleSlots       = 0;       // Bit per Slot past the stale timeout. Slots never updated aren't stale
+        bool         oscPortOpen      = false;   // False if UDP port 9001 couldn't be opened (e.g. another instance has it)
+        bool         framePortOpen    = false;   // False if UDP port 9002 couldn't be bound: no frame thread is running
+    };
+    
     OSCHandler();
     ~OSCHandler();
     
+    /**
+     Copies out the latest published Snapshot. Lock-free and safe from any thread, including the
+     audio thread: retries (without blocking) only if an update is being published mid-copy
+     */
+    Snapshot getSnapshot() const;
+    
+    /**
+     Like getSnapshot( ), but the values are the ones at timeMs (Time::getMillisecondCounterHiRes( ))
+     minus the buffer delay, with the continuous sensors interpolated between updates
+     */
+    Snapshot getBufferedSnapshot(double timeMs) const;
+    
+    /// Sets how far getBufferedSnapshot( ) reads behind real time, in ms: latency traded for smoothness
+    void setBufferDelay(float delayMs);
+    
+    /// Sets how long a sensor can go without an update before getBufferedSnapshot( ) fades it to its safe value, in ms
+    void setStaleTimeout(float timeoutMs);
+    
+    /// Returns the link statistics as of timeMs (Time::getMillisecondCounterHiRes( )). Safe from any thread
+    LinkStats getLinkStats(double timeMs) const;
+    
+    /// Zeroes the frame counters
+    void resetLinkStats();
+    
+    /// Returns the last value received for a Slot. Use getSnapshot( ) when several values need to match
+    float getValue(int slot) const;
+    
+    /// Returns the slot for an OSC address, or -1 if it isn't one of ours. Doesn't allocate
+    static int findSlot(const juce::String& address);
+    
     /// Returns float value of Accelerometer X Axis
     float getAccelX();
     
@@ -124,86 +237,90 @@ public:
     void callArduino();
     
 private:
-    /// Automatically called when an OSC Message comes in. Checks the address, and sets appropriate variable with incoming float
+    /// Called on the OSC receiver thread when an OSC Message comes in. Stores the incoming float and publishes it
     void oscMessageReceived (const juce::OSCMessage& message) override;
 
     /**
-     Automatically called when OSC Bundle comes in, splits bundle into its elements, and calls either
-     oscMessageReceived or oscBundleReceived depending on which type the element of the bundle is
+     Automatically called when OSC Bundle comes in, stores every message in it (and in any nested
+     bundles), then publishes once so the whole bundle shows up in the same Snapshot
      */
     void oscBundleReceived (const juce::OSCBundle& bundle) override;
     
-    juce::OSCAddress accelXAddress;
-    juce::OSCAddress accelYAddress;
-    juce::OSCAddress accelZAddress;
-    
-    juce::OSCAddress gyroXAddress;
-    juce::OSCAddress gyroYAddress;
-    juce::OSCAddress gyroZAddress;
-    
-    juce::OSCAddress distanceAddress;
-    
-    juce::OSCAddress touchXAddress;
-    juce::OSCAddress touchYAddress;
-    juce::OSCAddress touchZAddress;
-    
-    juce::OSCAddress accelXOnOffAddress;
-    juce::OSCAddress accelYOnOffAddress;
-    juce::OSCAddress accelZOnOffAddress;
+    /// Thread that reads binary frames off the frame socket
+    class FrameReceiver : public juce::Thread
+    {
+    public:
+        FrameReceiver (OSCHandler& handler) :
+            juce::Thread ( "Sensor Frame Receiver" ),
+            owner        ( handler )
+        {}
+        
+        void run() override   { owner.receiveFrames(); }
+        
+    private:
+        OSCHandler& owner;
+    };
+    
+    /// Runs on the FrameReceiver: waits on the frame socket and decodes each datagram in place
+    void receiveFrames();
+    
+    /// Stores every message in a bundle, and in any bundles nested in it
+    void storeBundle (const juce::OSCBundle& bundle, double arrivalMs);
+    
+    /// Looks up the address slot and stores the incoming float in the receiver's working copy
+    void storeMessage (const juce::OSCMessage& message, double arrivalMs);
+    
+    /// Copies a valid frame's values and buttons into the working copy
+    void storeFrame (const SensorFrame::View& frame, double arrivalMs);
     
-    juce::OSCAddress gyroXOnOffAddress;
-    juce::OSCAddress gyroYOnOffAddress;
-    juce::OSCAddress gyroZOnOffAddress;
-    
-    juce::OSCAddress touchXOnOffAddress;
-    juce::OSCAddress touchYOnOffAddress;
-    juce::OSCAddress touchZOnOffAddress;
-    
-    juce::OSCAddress distanceOnOffAddress;
-    
-    juce::OSCAddress filterTypeAddress;
-    juce::OSCAddress filterPoleAddress;
-    
-    juce::OSCAddress encoder1Address;
-    juce::OSCAddress encoder2Address;
-    
-    juce::OSCAddress encButton1Address;
-    juce::OSCAddress encButton2Address;
-    
-    
-    float accelXVal;
-    float accelYVal;
-    float accelZVal;
-    
-    float gyroXVal;
-    float gyroYVal;
-    float gyroZVal;
-    
-    float distVal;
-    
-    float touchXVal;
-    float touchYVal;
-    float touchZVal;
-    
-    float accelXOnOff;
-    float accelYOnOff;
-    float accelZOnOff;
-    
-    float gyroXOnOff;
-    float gyroYOnOff;
-    float gyroZOnOff;
-    
-    float touchXOnOff;
-    float touchYOnOff;
-    float touchZOnOff;
-    
-    float distanceOnOff;
-    
-    float filtType;
-    float filtPole;
+    /**
+     Counts lost, reordered and duplicated frames from a frame's sequence number. Returns true if
+     the frame is the newest seen, false if it's older or a repeat. deviceClockJumped re-anchors on
+     a sequence that went backwards: the Arduino rebooted. Call with writerLock held
+     */
+    bool trackSequence (juce::uint32 frameSequence, bool deviceClockJumped);
     
-    float encoder1;
-    float encoder2;
-    float encButton1;
-    float encButton2;
+    /**
+     Publishes the working copy as the next Snapshot (seqlock write), and into the jitter buffer
+     stamped timeMs if buffered is true. Call with writerLock held
+     */
+    void publish(double timeMs, bool buffered);
+    
+    /// Returns true if a binary frame has arrived within the stale timeout. Call with writerLock held
+    bool isFrameLinkActive(double timeMs) const;
+    
+    // Binary frames
+    juce::DatagramSocket           frameSocket;
+    std::unique_ptr<FrameReceiver> frameReceiver;
+    char                           frameBuffer[512];
+    
+    // Whether each port could be opened. Set once by the constructor
+    bool oscPortOpen;
+    bool framePortOpen;
+    
+    // Working copy. Both receiver threads write it, so they hold writerLock; readers never do
+    juce::SpinLock writerLock;
+    float          received[numSlots];
+    juce::uint32   receivedButtons;
+    
+    // Published values. The sequence is odd while a publish is in progress
+    std::atomic<float>        published[numSlots];
+    std::atomic<juce::uint32> publishedButtons { 0 };
+    std::atomic<juce::uint32> sequence         { 0 };
+    
+    // Timestamped history for getBufferedSnapshot( ), written under writerLock
+    std::unique_ptr<SensorJitterBuffer> jitterBuffer;
+    double                              lastFrameArrivalMs;     // Host time of the newest binary frame
+    
+    // Link monitoring. The sequence tracking is writer-side, the rest is read from any thread
+    bool                      hasFrameSequence;
+    juce::uint32              expectedSequence;
+    juce::uint64              recentSequences;          // Bit n set: the frame n behind the newest has arrived
+    std::atomic<juce::uint32> framesReceived   { 0 };
+    std::atomic<juce::uint32> framesLost       { 0 };
+    std::atomic<juce::uint32> framesReordered  { 0 };
+    std::atomic<juce::uint32> framesLate       { 0 };
+    std::atomic<juce::uint32> framesDuplicated { 0 };
+    std::atomic<double>       lastUpdate[numSlots];     // Arrival time per Slot, negative = never
+    std::atomic<float>        staleTimeout;
 };
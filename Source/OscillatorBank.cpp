@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+    OscillatorBank.cpp
+    Created: 17 Oct 2026 7:04:51pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#include "OscillatorBank.h"
+
+OscillatorBank::OscillatorBank() :
+    sampleRate ( 44100.0 )
+{
+    for (int lane = 0; lane < numLanes; lane++)
+    {
+        phases[lane]      = 0.0;
+        phaseDeltas[lane] = 0.0;
+        frequencies[lane] = 0.0f;
+        pulseWidths[lane] = 0.5f;
+        shapes[lane]      = sineShape;
+    }
+}
+
+OscillatorBank::~OscillatorBank() {}
+
+
+/// Sets the sample rate and restarts every lane
+void OscillatorBank::prepare(double SR)
+{
+    sampleRate = SR;
+    
+    for (int lane = 0; lane < numLanes; lane++)
+        phaseDeltas[lane] = frequencies[lane] / sampleRate;
+    
+    reset();
+}
+
+
+/// Restarts every lane at phase 0
+void OscillatorBank::reset()
+{
+    for (int lane = 0; lane < numLanes; lane++)
+        phases[lane] = 0.0;
+}
+
+
+/// Sets a lane's waveform
+void OscillatorBank::setShape(int lane, Shape newShape)
+{
+    jassert ( juce::isPositiveAndBelow ( lane, numLanes ) );
+    
+    shapes[lane] = newShape;
+}
+
+
+/// Sets a lane's frequency in Hz
+void OscillatorBank::setFrequency(int lane, float freq)
+{
+    jassert ( juce::isPositiveAndBelow ( lane, numLanes ) );
+    
+    frequencies[lane] = freq;
+    phaseDeltas[lane] = freq / sampleRate;
+}
+
+
+/// Sets a lane's pulse width (square, sparse and square I/O shapes), 0 to 1
+void OscillatorBank::setPulseWidth(int lane, float pw)
+{
+    jassert ( juce::isPositiveAndBelow ( lane, numLanes ) );
+    
+    // Kept off 0 so the sparse shape never divides by zero
+    pulseWidths[lane] = juce::jlimit ( 0.001f, 1.0f, pw );
+}
+
+
+/// Sets a lane's phase, 0 to 1
+void OscillatorBank::setPhase(int lane, double newPhase)
+{
+    jassert ( juce::isPositiveAndBelow ( lane, numLanes ) );
+    
+    phases[lane] = newPhase - std::floor ( newPhase );
+}
+
+
+/// Advances every lane by numSamples. Use once per control period
+void OscillatorBank::advance(int numSamples)
+{
+    // Same loop for every lane, no branches: vectorises
+    for (int lane = 0; lane < numLanes; lane++)
+    {
+        double phase = phases[lane] + phaseDeltas[lane] * numSamples;
+        phases[lane] = phase - std::floor ( phase );
+    }
+}
+
+
+/// Writes the current output of every lane to laneOutputs[numLanes]
+void OscillatorBank::getOutputs(float* laneOutputs) const
+{
+    for (int lane = 0; lane < numLanes; lane++)
+        laneOutputs[lane] = shapeLane ( lane, static_cast<float>( phases[lane] ) );
+}
+
+
+/// Audio rate: advances one sample and writes every lane's output to laneOutputs[numLanes]
+void OscillatorBank::process(float* laneOutputs)
+{
+    advance ( 1 );
+    getOutputs ( laneOutputs );
+}
+
+
+/// Renders numSamples of every lane at audio rate into laneBuffers[lane]
+void OscillatorBank::renderBlock(float* const* laneBuffers, int numSamples)
+{
+    // Phases first, lanes side by side, then each lane's shape over its own buffer
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        advance ( 1 );
+        
+        for (int lane = 0; lane < numLanes; lane++)
+            laneBuffers[lane][sample] = static_cast<float>( phases[lane] );
+    }
+    
+    for (int lane = 0; lane < numLanes; lane++)
+    {
+        float* buffer = laneBuffers[lane];
+        float  pw     = pulseWidths[lane];
+        
+        switch (shapes[lane])
+        {
+            case phaseShape:
+                break;
+            case triangleShape:
+                for (int sample = 0; sample < numSamples; sample++) buffer[sample] = OscillatorShapes::triangle ( buffer[sample] );
+                break;
+            case sineShape:
+                for (int sample = 0; sample < numSamples; sample++) buffer[sample] = OscillatorShapes::sine ( buffer[sample] );
+                break;
+            case squareShape:
+                for (int sample = 0; sample < numSamples; sample++) buffer[sample] = OscillatorShapes::square ( buffer[sample], pw );
+                break;
+            case sawtoothShape:
+                for (int sample = 0; sample < numSamples; sample++) buffer[sample] = OscillatorShapes::sawtooth ( buffer[sample] );
+                break;
+            case sparseShape:
+                for (int sample = 0; sample < numSamples; sample++) buffer[sample] = OscillatorShapes::sparse ( buffer[sample], pw );
+                break;
+            case squareIOShape:
+                for (int sample = 0; sample < numSamples; sample++) buffer[sample] = OscillatorShapes::squareIO ( buffer[sample], pw );
+                break;
+        }
+    }
+}
+
+
+/// A lane's waveform at phase p
+float OscillatorBank::shapeLane(int lane, float p) const
+{
+    switch (shapes[lane])
+    {
+        case triangleShape: return OscillatorShapes::triangle ( p );
+        case sineShape:     return OscillatorShapes::sine     ( p );
+        case squareShape:   return OscillatorShapes::square   ( p, pulseWidths[lane] );
+        case sawtoothShape: return OscillatorShapes::sawtooth ( p );
+        case sparseShape:   return OscillatorShapes::sparse   ( p, pulseWidths[lane] );
+        case squareIOShape: return OscillatorShapes::squareIO ( p, pulseWidths[lane] );
+        case phaseShape:
+        default:            return OscillatorShapes::phase    ( p );
+    }
+}
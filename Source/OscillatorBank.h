@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    OscillatorBank.h
+    Created: 17 Oct 2026 7:04:51pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Oscillators.h"
+
+/**
+ Eight independent modulation oscillators advanced together.
+
+ Lane state is kept as structure-of-arrays (one aligned array per field), so the
+ phase update for all lanes is a single loop the compiler turns into vector ops.
+ Each lane has its own shape, frequency and pulse width.
+
+ Modulation rarely needs audio rate: advance( ) steps every lane by a whole
+ control period at once and the outputs are read once per period, which makes
+ a full bank cheaper than running a single oscillator per sample.
+ ModulationEngine runs its sparse and square I/O LFOs on the first two lanes.
+ */
+class OscillatorBank
+{
+public:
+    static constexpr int numLanes = 8;
+    
+    enum Shape
+    {
+        phaseShape = 0,
+        triangleShape,
+        sineShape,
+        squareShape,
+        sawtoothShape,
+        sparseShape,
+        squareIOShape
+    };
+    
+    OscillatorBank();
+    ~OscillatorBank();
+    
+    /// Sets the sample rate and restarts every lane
+    void prepare(double SR);
+    
+    /// Restarts every lane at phase 0
+    void reset();
+    
+    /// Sets a lane's waveform
+    void setShape(int lane, Shape newShape);
+    
+    /// Sets a lane's frequency in Hz
+    void setFrequency(int lane, float freq);
+    
+    /// Sets a lane's pulse width (square, sparse and square I/O shapes), 0 to 1
+    void setPulseWidth(int lane, float pw);
+    
+    /// Sets a lane's phase, 0 to 1
+    void setPhase(int lane, double newPhase);
+    
+    /// Advances every lane by numSamples. Use once per control period
+    void advance(int numSamples);
+    
+    /// Writes the current output of every lane to laneOutputs[numLanes]
+    void getOutputs(float* laneOutputs) const;
+    
+    /// Audio rate: advances one sample and writes every lane's output to laneOutputs[numLanes]
+    void process(float* laneOutputs);
+    
+    /// Renders numSamples of every lane at audio rate into laneBuffers[lane]
+    void renderBlock(float* const* laneBuffers, int numSamples);
+    
+private:
+    /// A lane's waveform at phase p
+    float shapeLane(int lane, float p) const;
+    
+    double sampleRate;
+    
+    // Lane state, one array per field
+    alignas(32) double phases[numLanes];
+    alignas(32) double phaseDeltas[numLanes];
+    alignas(32) float  frequencies[numLanes];
+    alignas(32) float  pulseWidths[numLanes];
+    Shape              shapes[numLanes];
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OscillatorBank)
+};
@@ -14,48 +14,123 @@
 
 
 //
-//=== Phasor Class ===================================================
+//=== Oscillator Shapes ===================================================
+//
+
+/// The waveforms as plain functions of phase (0 to 1), shared by the oscillators and OscillatorBank
+namespace OscillatorShapes
+{
+    inline float phase(float p)     { return p; }
+    inline float triangle(float p)  { return std::abs ( p - 0.5f ) - 0.5f; }
+    inline float sine(float p)      { return std::sin ( p * juce::MathConstants<float>::twoPi ); }
+    inline float sawtooth(float p)  { return p - 0.5f; }
+    
+    inline float square(float p, float pulseWidth)   { return p > pulseWidth ? -0.5f : 0.5f; }
+    inline float squareIO(float p, float pulseWidth) { return p > pulseWidth ?  0.0f : 1.0f; }
+    
+    /// Squared sine half cycle over the pulse width, silent after it
+    inline float sparse(float p, float pulseWidth)
+    {
+        float outVal = std::sin ( p * juce::MathConstants<float>::pi / pulseWidth );
+        
+        return p > pulseWidth ? 0.0f : outVal * outVal;
+    }
+}
+
+
+//
+//=== OscillatorCore Class ===================================================
 //
 
-class Phasor
+/**
+ Phase accumulator shared by the oscillators, templated on the oscillator itself (CRTP)
+ so Derived::output( ) is resolved at compile time and inlines into the loops.
+ 
+ Phase is kept in double so long runs don't drift. renderBlock( ) writes the phases
+ for the block first and shapes them in a second, branch-free loop the compiler can
+ vectorise.
+ */
+template <typename Derived>
+class OscillatorCore
 {
 public:
-    
-    // Our parent oscillator class does the key things required for most oscillators:
-    // -- handles phase
-    // -- handles setters and getters for frequency and samplerate
-    
-    /// Constructor
-    Phasor();
-    
-    /// virtual desctructor
-    virtual ~Phasor();
-    
     /// update the phase and output the next sample from the oscillator
-    float process();
-    
-    /// Phase
-    virtual float output(float p);
+    float process()
+    {
+        advance();
+        
+        return static_cast<Derived*>( this )->output ( static_cast<float>( phase ) );
+    }
+    
+    /// Renders numSamples of output into out
+    void renderBlock(float* out, int numSamples)
+    {
+        for (int sample = 0; sample < numSamples; sample++)
+        {
+            advance();
+            out[sample] = static_cast<float>( phase );
+        }
+        
+        auto& self = *static_cast<Derived*>( this );
+        
+        for (int sample = 0; sample < numSamples; sample++)
+            out[sample] = self.output ( out[sample] );
+    }
     
     /// Sets sampleRate
-    void setSampleRate(float SR);
+    void setSampleRate(float SR)
+    {
+        sampleRate = SR;
+        phaseDelta = frequency / sampleRate;
+    }
     
     /// Sets oscillator frequency
-    void setFrequency(float freq);
+    void setFrequency(float freq)
+    {
+        frequency  = freq;
+        phaseDelta = frequency / sampleRate;
+    }
+    
+    /// Sets the phase, 0 to 1
+    void setPhase(double newPhase) { phase = newPhase - std::floor ( newPhase ); }
     
-    // TESTING
     /// Returns frequency
-    float getFreq();
+    float getFreq() const { return static_cast<float>( frequency ); }
     
     /// Returns sampleRate
-    float getSR();
+    float getSR() const   { return static_cast<float>( sampleRate ); }
+    
+    
+protected:
+    OscillatorCore()  = default;
+    ~OscillatorCore() = default;
     
     
 private:
-    float frequency;
-    float sampleRate;
-    float phase;
-    float phaseDelta;
+    void advance()
+    {
+        phase += phaseDelta;
+        
+        if (phase > 1.0)
+            phase -= 1.0;
+    }
+    
+    double frequency  { 0.0     };
+    double sampleRate { 44100.0 };
+    double phase      { 0.0     };
+    double phaseDelta { 0.0     };
+};
+
+
+//
+//=== Phasor Class ===================================================
+//
+
+/// Outputs the raw phase, a 0 to 1 ramp
+class Phasor : public OscillatorCore<Phasor>
+{
+public:
+    float output(float p) const { return OscillatorShapes::phase ( p ); }
 };
 
 
@@ -63,9 +138,10 @@ private:
 //=== TriOsc Class ===================================================
 //
 
-class TriOsc : public Phasor
+class TriOsc : public OscillatorCore<TriOsc>
 {
-    float output(float p) override;
+public:
+    float output(float p) const { return OscillatorShapes::triangle ( p ); }
 };
 
 
@@ -73,16 +149,10 @@ class TriOsc : public Phasor
 //=== SinOsc Class ===================================================
 //
 
-class SinOsc : public Phasor
+class SinOsc : public OscillatorCore<SinOsc>
 {
 public:
-    /// Constructor
-    SinOsc();
-    
-    float output(float p) override;
-    
-private:
-    float TWOPI;
+    float output(float p) const { return OscillatorShapes::sine ( p ); }
 };
 
 
@@ -90,13 +160,13 @@ private:
 //=== SquareOsc Class ===================================================
 //
 
-class SquareOsc : public Phasor
+class SquareOsc : public OscillatorCore<SquareOsc>
 {
 public:
     /// Constructor
     SquareOsc();
     
-    float output(float p) override;
+    float output(float p) const { return OscillatorShapes::square ( p, pulseWidth ); }
     
     /// Sets pulswidth
     void setPulseWidth(float pw);
@@ -109,10 +179,10 @@ private:
 //
 //=== SawtoothOsc Class ===================================================
 //
-class SawtoothOsc : public Phasor
+class SawtoothOsc : public OscillatorCore<SawtoothOsc>
 {
-    float output(float p) override;
-    
+public:
+    float output(float p) const { return OscillatorShapes::sawtooth ( p ); }
 };
 
 
@@ -121,13 +191,13 @@ class SawtoothOsc : public Phasor
 //
 
 /// Sine wave, silent after the pulseWidth
-class SparseLFO : public Phasor
+class SparseLFO : public OscillatorCore<SparseLFO>
 {
 public:
     /// Constructor
     SparseLFO();
     
-    float output(float p) override;
+    float output(float p) const { return OscillatorShapes::sparse ( p, pulseWidth ); }
     
     /// Sets pulseWidth: float between 0.0 and 1.0
     void setPulseWidth(float pw);
@@ -135,7 +205,6 @@ public:
         
 private:
     float pulseWidth;
-    float TWOPI;
 };
 
 
@@ -144,13 +213,13 @@ private:
 //
 
 /// Outputs 1.0f for pulseWidth, then outputs 0.0f
-class SquareIOLFO : public Phasor
+class SquareIOLFO : public OscillatorCore<SquareIOLFO>
 {
 public:
     /// Constructor
     SquareIOLFO();
     
-    float output(float p) override;
+    float output(float p) const { return OscillatorShapes::squareIO ( p, pulseWidth ); }
     
     /// sets pulseWidth between 0.0f and 1.0f
     void setPulseWidth(float pw);
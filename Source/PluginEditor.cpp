@@ -46,7 +46,7 @@ BassOnboardAudioProcessorEditor::BassOnboardAudioProcessorEditor (BassOnboardAud
     fieryRose      ( juce::Colour( 0xFFFF6872 ) ),
     orangePeel     ( juce::Colour( 0xFFFC9800 ) ),
     transparent    ( juce::Colour( 0x00000000 ) ),
-    osc         ( std::make_unique<OSCHandler>()  ),
+    osc         ( &audioProcessor.getOSCHandler() ),
     titleHeader ( std::make_unique<TitleHeader>() ),
     titleFooter ( std::make_unique<TitleFooter>() ),
     currentEncoderMapping ( 0 ),
@@ -523,6 +523,9 @@ void BassOnboardAudioProcessorEditor::resized()
 
 void BassOnboardAudioProcessorEditor::timerCallback()
 {
+    // One consistent frame of sensor values for this tick, smoothed by the jitter buffer
+    sensors = osc->getBufferedSnapshot ( juce::Time::getMillisecondCounterHiRes() );
+    
     sensorOnOffController();    // Update Sensor On/Off Parameters
     sensorMapping();            // Send sensor values to mapped parameters
     encoderMapping();           // Send encoder values to mapped parameters
@@ -587,11 +590,11 @@ void BassOnboardAudioProcessorEditor::onOffBoxSetup(juce::ComboBox &boxInstance)
 void BassOnboardAudioProcessorEditor::filterController()
 {
     // Change filter type LPF/HPF/BPF
-    if (filtTypeBox.getSelectedId() != osc->getFiltType() + 1.0f)
-        filtTypeBox.setSelectedId( osc->getFiltType() + 1.0f );
+    if (filtTypeBox.getSelectedId() != sensors.get ( OSCHandler::filterTypeSlot ) + 1.0f)
+        filtTypeBox.setSelectedId( sensors.get ( OSCHandler::filterTypeSlot ) + 1.0f );
     
     // Change Filter Poles -12dB/-24dB
-    float pole = osc->getFiltPole();
+    float pole = sensors.get ( OSCHandler::filterPoleSlot );
     
     if (pole == -1.0f)
         pole = 2.0f;
@@ -605,7 +608,7 @@ void BassOnboardAudioProcessorEditor::filterController()
     
     if (cutoffOn == 2.0f)
     {
-        float cutoffMap = juce::jmap   ( osc->getTouchY(), 300.0f, 800.0f, 45.0f, 15000.0f );   // Map touchscreen values to parameter values
+        float cutoffMap = juce::jmap   ( sensors.get ( OSCHandler::touchYSlot ), 300.0f, 800.0f, 45.0f, 15000.0f );   // Map touchscreen values to parameter values
         
         cutoffMap = juce::jlimit( 20.0f, 18000.0f, cutoffMap ); // Limit values to parameter range
         
@@ -616,7 +619,7 @@ void BassOnboardAudioProcessorEditor::filterController()
     
     if (resOn == 2.0f)
     {
-        float resMap = juce::jmap ( osc->getTouchX(), 300.0f, 800.0f, 0.9f,  2.4f     );  // Map touchscreen values to parameter values
+        float resMap = juce::jmap ( sensors.get ( OSCHandler::touchXSlot ), 300.0f, 800.0f, 0.9f,  2.4f     );  // Map touchscreen values to parameter values
         
         resMap = juce::jlimit( 0.7f, 2.5f, resMap );  // Limit values to parameter range
         
@@ -630,19 +633,19 @@ void BassOnboardAudioProcessorEditor::filterController()
 void BassOnboardAudioProcessorEditor::sensorOnOffController()
 {
     // Converts -1 Off/1 On values from Arduino to match 1 Off & 2 On values of ComboBox
-    float aX = ( osc->getAccelXOnOff() == 1.0f ) ? 2.0f : 1.0f;
-    float aY = ( osc->getAccelYOnOff() == 1.0f ) ? 2.0f : 1.0f;
-    float aZ = ( osc->getAccelZOnOff() == 1.0f ) ? 2.0f : 1.0f;
+    float aX = ( sensors.get ( OSCHandler::accelXOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
+    float aY = ( sensors.get ( OSCHandler::accelYOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
+    float aZ = ( sensors.get ( OSCHandler::accelZOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
     
-    float gX = ( osc->getGyroXOnOff() == 1.0f ) ? 2.0f : 1.0f;
-    float gY = ( osc->getGyroYOnOff() == 1.0f ) ? 2.0f : 1.0f;
-    float gZ = ( osc->getGyroZOnOff() == 1.0f ) ? 2.0f : 1.0f;
+    float gX = ( sensors.get ( OSCHandler::gyroXOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
+    float gY = ( sensors.get ( OSCHandler::gyroYOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
+    float gZ = ( sensors.get ( OSCHandler::gyroZOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
     
-    float tX = ( osc->getTouchXOnOff() == 1.0f ) ? 2.0f : 1.0f;
-    float tY = ( osc->getTouchYOnOff() == 1.0f ) ? 2.0f : 1.0f;
-    float tZ = ( osc->getTouchZOnOff() == 1.0f ) ? 2.0f : 1.0f;
+    float tX = ( sensors.get ( OSCHandler::touchXOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
+    float tY = ( sensors.get ( OSCHandler::touchYOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
+    float tZ = ( sensors.get ( OSCHandler::touchZOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
     
-    float dis = (osc->getDistanceOnOff() == 1.0f ) ? 2.0f : 1.0f;
+    float dis = (sensors.get ( OSCHandler::distanceOnOffSlot ) == 1.0f ) ? 2.0f : 1.0f;
     
     // If the button flipped the value, change the ComboBox value
     if (accelXOnOffBox.getSelectedId() != aX)
@@ -687,11 +690,11 @@ void BassOnboardAudioProcessorEditor::sensorOnOffController()
 void BassOnboardAudioProcessorEditor::encoderMapping()
 {
     // Get value from Rotary Encoders
-    float enc1Val = osc->getEncoder1();
-    float enc2Val = osc->getEncoder2();
+    float enc1Val = sensors.get ( OSCHandler::encoder1Slot );
+    float enc2Val = sensors.get ( OSCHandler::encoder2Slot );
     
     // Encoder1 Button presses cycle through Rotary Encoder Mappings 0 - 6
-    switch ((int)osc->getEncButton1())
+    switch ((int)sensors.get ( OSCHandler::encButton1Slot ))
     {
         // Enc1 = outGain; Enc2 = Haas;
         case 0:
@@ -803,7 +806,7 @@ void BassOnboardAudioProcessorEditor::encoderMapValueSet(float encVal, float& pa
 /// encoderButton2 Presse cycle through sensor mappings to parameters
 void BassOnboardAudioProcessorEditor::sensorMapping()
 {
-    switch ((int)osc->getEncButton2())
+    switch ((int)sensors.get ( OSCHandler::encButton2Slot ))
     {
         case 0:
             sensorMap0();
@@ -830,54 +833,54 @@ void BassOnboardAudioProcessorEditor::sensorMapping()
 void BassOnboardAudioProcessorEditor::sensorMap0()
 {
     // AccelX to Waveshape Amt
-    sensorMapValueSet( accelXOnOffBox, wsAmtOverride, wsAmtSlider, osc->getAccelX(), -4.0f, 4.0f, 1.0f, 200.0f );
+    sensorMapValueSet( accelXOnOffBox, wsAmtOverride, wsAmtSlider, sensors.get ( OSCHandler::accelXSlot ), -4.0f, 4.0f, 1.0f, 200.0f );
     
     // AccelY to Foldback Amt
-    sensorMapValueSet( accelYOnOffBox, fbAmtOverride, fbAmtSlider, osc->getAccelY(), -4.0f, 4.0f, 1.0f, 200.0f );
+    sensorMapValueSet( accelYOnOffBox, fbAmtOverride, fbAmtSlider, sensors.get ( OSCHandler::accelYSlot ), -4.0f, 4.0f, 1.0f, 200.0f );
     
     // AccelZ to Bitcrush Amt
-    sensorMapValueSet( accelZOnOffBox, bcAmtOverride, bcAmtSlider, osc->getAccelZ(), -4.0f, 4.0f, 0.0f, 1.0f );
+    sensorMapValueSet( accelZOnOffBox, bcAmtOverride, bcAmtSlider, sensors.get ( OSCHandler::accelZSlot ), -4.0f, 4.0f, 0.0f, 1.0f );
     
     // Distance to Formant Morph
-    sensorMapValueSet( distanceOnOffBox, formMorphOverride, formMorphSlider, osc->getDistance(), 0.0f, 1200.0f, 0.0f, 9.0f );
+    sensorMapValueSet( distanceOnOffBox, formMorphOverride, formMorphSlider, sensors.get ( OSCHandler::distanceSlot ), 0.0f, 1200.0f, 0.0f, 9.0f );
     
     // GyroX to Delay Time
-    sensorMapValueSet( gyroXOnOffBox, delayTimeOverride, delayTimeSlider, osc->getGyroX(), -2000.0f, 2000.0f, 0.0f, 1.0f );
+    sensorMapValueSet( gyroXOnOffBox, delayTimeOverride, delayTimeSlider, sensors.get ( OSCHandler::gyroXSlot ), -2000.0f, 2000.0f, 0.0f, 1.0f );
 }
 
 // See Sensor Maps comment above
 void BassOnboardAudioProcessorEditor::sensorMap1()
 {
     // AccelX to Waveshape Amt
-    sensorMapValueSet( accelXOnOffBox, wsAmtOverride, wsAmtSlider, osc->getAccelX(), -4.0f, 4.0f, 1.0f, 200.0f );
+    sensorMapValueSet( accelXOnOffBox, wsAmtOverride, wsAmtSlider, sensors.get ( OSCHandler::accelXSlot ), -4.0f, 4.0f, 1.0f, 200.0f );
     
     // AccelY to Foldback Amt
-    sensorMapValueSet( accelYOnOffBox, fbAmtOverride, fbAmtSlider, osc->getAccelY(), -4.0f, 4.0f, 1.0f, 200.0f );
+    sensorMapValueSet( accelYOnOffBox, fbAmtOverride, fbAmtSlider, sensors.get ( OSCHandler::accelYSlot ), -4.0f, 4.0f, 1.0f, 200.0f );
     
     // AccelZ to Bitcrush Amt
-    sensorMapValueSet( accelZOnOffBox, bcAmtOverride, bcAmtSlider, osc->getAccelZ(), -4.0f, 4.0f, 0.0f, 1.0f );
+    sensorMapValueSet( accelZOnOffBox, bcAmtOverride, bcAmtSlider, sensors.get ( OSCHandler::accelZSlot ), -4.0f, 4.0f, 0.0f, 1.0f );
     
     // GyroX to formant morph
-    sensorMapValueSet( gyroXOnOffBox, formMorphOverride, formMorphSlider, osc->getGyroX(), -2000.0f, 2000.0f, 0.0f, 9.0f );
+    sensorMapValueSet( gyroXOnOffBox, formMorphOverride, formMorphSlider, sensors.get ( OSCHandler::gyroXSlot ), -2000.0f, 2000.0f, 0.0f, 9.0f );
     
     // Distance to delay time
-    sensorMapValueSet( distanceOnOffBox, delayTimeOverride, delayTimeSlider, osc->getDistance(), 0.0f, 1200.0f, 0.0f, 1.0f );
+    sensorMapValueSet( distanceOnOffBox, delayTimeOverride, delayTimeSlider, sensors.get ( OSCHandler::distanceSlot ), 0.0f, 1200.0f, 0.0f, 1.0f );
 }
 
 // See Sensor Maps comment above
 void BassOnboardAudioProcessorEditor::sensorMap2()
 {
     // GyroX to WS Amt
-    sensorMapValueSet( gyroXOnOffBox, wsAmtOverride, wsAmtSlider, osc->getGyroX(), -2000.0f, 2000.0f, 1.0f, 200.0f );
+    sensorMapValueSet( gyroXOnOffBox, wsAmtOverride, wsAmtSlider, sensors.get ( OSCHandler::gyroXSlot ), -2000.0f, 2000.0f, 1.0f, 200.0f );
     
     // GyroY to FB Amt
-    sensorMapValueSet( gyroYOnOffBox, fbAmtOverride, fbAmtSlider, osc->getGyroY(), -2000.0f, 2000.0f, 1.0f, 200.0f );
+    sensorMapValueSet( gyroYOnOffBox, fbAmtOverride, fbAmtSlider, sensors.get ( OSCHandler::gyroYSlot ), -2000.0f, 2000.0f, 1.0f, 200.0f );
     
     // GyroZ to BC Amt
-    sensorMapValueSet( gyroZOnOffBox, bcAmtOverride, bcAmtSlider, osc->getGyroZ(), -2000.0f, 2000.0f, 0.0f, 1.0f );
+    sensorMapValueSet( gyroZOnOffBox, bcAmtOverride, bcAmtSlider, sensors.get ( OSCHandler::gyroZSlot ), -2000.0f, 2000.0f, 0.0f, 1.0f );
     
     // AccelX to Formant morph
-    sensorMapValueSet( accelXOnOffBox, formMorphOverride, formMorphSlider, osc->getAccelX(), -4.0f, 4.0f, 0.0f, 9.0f );
+    sensorMapValueSet( accelXOnOffBox, formMorphOverride, formMorphSlider, sensors.get ( OSCHandler::accelXSlot ), -4.0f, 4.0f, 0.0f, 9.0f );
 }
 
 /**
@@ -252,9 +252,11 @@ private:
     //DistanceMeter distanceMeter;
     //TouchScreen   touchScreen;
     
-    // OSC
-    std::unique_ptr<OSCHandler> osc;
-//    OSCHandler osc;
+    // OSC, owned by the processor
+    OSCHandler* osc;
+    
+    // Sensor values for the current timer tick, so every mapping sees the same frame
+    OSCHandler::Snapshot sensors;
     
     // Header/Footer
     std::unique_ptr<TitleHeader> titleHeader;
@@ -60,6 +60,21 @@ parameters(*this, nullptr, "ParameterTree",
     std::make_unique<juce::AudioParameterFloat> ( "bitcrushDryWet", "Bitcrush Dry/Wet",
                                                   juce::NormalisableRange<float>( 0.0f, 1.0f, 0.01f, 1.0f, false ),
                                                   0.0f, "" ),
+    std::make_unique<juce::AudioParameterFloat> ( "bitDepth", "Bitcrush Bit Depth",
+                                                  juce::NormalisableRange<float>( 1.0f, 16.0f, 0.01f, 1.0f, false ),
+                                                  16.0f, "bits" ),
+    std::make_unique<juce::AudioParameterChoice> ( "bitcrushDither", "Bitcrush Dither",
+                                                   juce::StringArray( {"Off", "TPDF", "Noise Shaped"} ), 0 ),
+    std::make_unique<juce::AudioParameterChoice> ( "bitcrushQuality", "Bitcrush Anti-Aliasing",
+                                                   juce::StringArray( {"Standard", "PolyBLEP"} ), 0 ),
+    std::make_unique<juce::AudioParameterChoice> ( "distOversampling", "Distortion Oversampling",
+                                                   juce::StringArray( {"Off", "2x", "4x", "8x"} ), 0 ),
+    std::make_unique<juce::AudioParameterChoice> ( "wsCurve", "Waveshape Curve",
+                                                   ShaperTables::getCurveNames(), 0 ),
+    std::make_unique<juce::AudioParameterChoice> ( "wsQuality", "Waveshape Anti-Aliasing",
+                                                   juce::StringArray( {"Standard", "ADAA"} ), 0 ),
+    std::make_unique<juce::AudioParameterChoice> ( "foldbackQuality", "Foldback Anti-Aliasing",
+                                                   juce::StringArray( {"Standard", "ADAA"} ), 0 ),
     // Formant Params
     std::make_unique<juce::AudioParameterFloat> ( "formantMorph", "Formant Morph",
                                                   juce::NormalisableRange<float>( 5.0f, 9.0f, 0.001f, 1.0f, false ),
@@ -91,6 +106,55 @@ parameters(*this, nullptr, "ParameterTree",
                                                    juce::StringArray( {"LPF", "BPF", "HPF"} ), 0 ),
     std::make_unique<juce::AudioParameterChoice> ( "svFiltPoles", "Filter Poles",
                                                    juce::StringArray( {"1 pole : -12dB", "2 pole : -24dB"} ), 0 ),
+    std::make_unique<juce::AudioParameterChoice> ( "filterControlRate", "Filter Control Rate",
+                                                   ControlRateFilter::getControlIntervalNames(), 3 ),
+    // Modulation Params
+    std::make_unique<juce::AudioParameterFloat> ( "sparseLFORate", "Sparse LFO Rate",
+                                                  juce::NormalisableRange<float>( 0.01f, 20.0f, 0.01f, 0.3f, false ),
+                                                  1.0f, "Hz" ),
+    std::make_unique<juce::AudioParameterFloat> ( "sparseLFOWidth", "Sparse LFO Width",
+                                                  juce::NormalisableRange<float>( 0.01f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.5f, "" ),
+    std::make_unique<juce::AudioParameterFloat> ( "squareIOLFORate", "Square I/O LFO Rate",
+                                                  juce::NormalisableRange<float>( 0.01f, 20.0f, 0.01f, 0.3f, false ),
+                                                  1.0f, "Hz" ),
+    std::make_unique<juce::AudioParameterFloat> ( "squareIOLFOWidth", "Square I/O LFO Width",
+                                                  juce::NormalisableRange<float>( 0.0f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.5f, "" ),
+    std::make_unique<juce::AudioParameterChoice> ( "modControlRate", "Modulation Control Rate",
+                                                   ModulationEngine::getControlRateNames(), 2 ),
+    std::make_unique<juce::AudioParameterChoice> ( "wsAmtModSource", "Waveshape Amount Mod Source",
+                                                   ModulationEngine::getSourceNames(), 0 ),
+    std::make_unique<juce::AudioParameterFloat> ( "wsAmtModDepth", "Waveshape Amount Mod Depth",
+                                                  juce::NormalisableRange<float>( -1.0f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.0f, "" ),
+    std::make_unique<juce::AudioParameterFloat> ( "wsAmtModOffset", "Waveshape Amount Mod Offset",
+                                                  juce::NormalisableRange<float>( -1.0f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.0f, "" ),
+    std::make_unique<juce::AudioParameterChoice> ( "formantMorphModSource", "Formant Morph Mod Source",
+                                                   ModulationEngine::getSourceNames(), 0 ),
+    std::make_unique<juce::AudioParameterFloat> ( "formantMorphModDepth", "Formant Morph Mod Depth",
+                                                  juce::NormalisableRange<float>( -1.0f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.0f, "" ),
+    std::make_unique<juce::AudioParameterFloat> ( "formantMorphModOffset", "Formant Morph Mod Offset",
+                                                  juce::NormalisableRange<float>( -1.0f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.0f, "" ),
+    std::make_unique<juce::AudioParameterChoice> ( "svFiltCutoffModSource", "Filter Cutoff Mod Source",
+                                                   ModulationEngine::getSourceNames(), 0 ),
+    std::make_unique<juce::AudioParameterFloat> ( "svFiltCutoffModDepth", "Filter Cutoff Mod Depth",
+                                                  juce::NormalisableRange<float>( -1.0f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.0f, "" ),
+    std::make_unique<juce::AudioParameterFloat> ( "svFiltCutoffModOffset", "Filter Cutoff Mod Offset",
+                                                  juce::NormalisableRange<float>( -1.0f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.0f, "" ),
+    std::make_unique<juce::AudioParameterChoice> ( "delayFXTimeModSource", "Delay FX Time Mod Source",
+                                                   ModulationEngine::getSourceNames(), 0 ),
+    std::make_unique<juce::AudioParameterFloat> ( "delayFXTimeModDepth", "Delay FX Time Mod Depth",
+                                                  juce::NormalisableRange<float>( -1.0f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.0f, "" ),
+    std::make_unique<juce::AudioParameterFloat> ( "delayFXTimeModOffset", "Delay FX Time Mod Offset",
+                                                  juce::NormalisableRange<float>( -1.0f, 1.0f, 0.01f, 1.0f, false ),
+                                                  0.0f, "" ),
     // Sensor On/Off Params
     std::make_unique<juce::AudioParameterChoice> ( "accelXOnOff", "Accel X On/Off",        juce::StringArray ( {"Off", "On"} ), 0 ),
     std::make_unique<juce::AudioParameterChoice> ( "accelYOnOff", "Accel Y On/Off",        juce::StringArray ( {"Off", "On"} ), 0 ),
@@ -101,13 +165,20 @@ parameters(*this, nullptr, "ParameterTree",
     std::make_unique<juce::AudioParameterChoice> ( "touchXOnOff", "Touch Screen X On/Off", juce::StringArray ( {"Off", "On"} ), 0 ),
     std::make_unique<juce::AudioParameterChoice> ( "touchYOnOff", "Touch Screen Y On/Off", juce::StringArray ( {"Off", "On"} ), 0 ),
     std::make_unique<juce::AudioParameterChoice> ( "touchZOnOff", "Touch Screen Z On/Off", juce::StringArray ( {"Off", "On"} ), 0 ),
-    std::make_unique<juce::AudioParameterChoice> ( "distOnOff",   "TDistance On/Off",      juce::StringArray ( {"Off", "On"} ), 0 )
+    std::make_unique<juce::AudioParameterChoice> ( "distOnOff",   "TDistance On/Off",      juce::StringArray ( {"Off", "On"} ), 0 ),
+    // Sensor Link Params
+    std::make_unique<juce::AudioParameterFloat> ( "sensorBufferMs", "Sensor Jitter Buffer",
+                                                  juce::NormalisableRange<float>( 0.0f, 100.0f, 0.1f, 1.0f, false ),
+                                                  20.0f, "ms" ),
+    std::make_unique<juce::AudioParameterFloat> ( "sensorTimeoutMs", "Sensor Stale Timeout",
+                                                  juce::NormalisableRange<float>( 50.0f, 5000.0f, 1.0f, 0.5f, false ),
+                                                  500.0f, "ms" )
 }),
-    waveShaper    ( std::make_unique<WaveShaper>()         ),
-    foldback      ( std::make_unique<FoldbackDistortion>() ),
-    bitCrush      ( std::make_unique<BitCrusher>()         ),
-    formant       ( std::make_unique<FormantFilter>()      ),
-    delayFXDryWet ( std::make_unique<DryWet>()             )
+    distortion    ( std::make_unique<DistortionChain>() ),
+    formant       ( std::make_unique<FormantFilter>()   ),
+    delayFXDryWet ( std::make_unique<DryWet>()          ),
+    modulation    ( std::make_unique<ModulationEngine>( parameters ) ),
+    osc           ( std::make_unique<OSCHandler>()      )
 // Constructor
 {
     // Gain Params
@@ -121,6 +192,14 @@ parameters(*this, nullptr, "ParameterTree",
     foldbackDryWetParam  = parameters.getRawParameterValue ( "foldbackDryWet" );
     bitCrushAmountParam  = parameters.getRawParameterValue ( "bitcrushAmt"    );
     bitCrushDryWetParam  = parameters.getRawParameterValue ( "bitcrushDryWet" );
+    bitDepthParam        = parameters.getRawParameterValue ( "bitDepth"       );
+    bitCrushDitherParam  = parameters.getRawParameterValue ( "bitcrushDither" );
+    bitCrushQualityParam = parameters.getRawParameterValue ( "bitcrushQuality" );
+    
+    distOversamplingParam = parameters.getRawParameterValue ( "distOversampling" );
+    waveShapeCurveParam   = parameters.getRawParameterValue ( "wsCurve"          );
+    waveShapeQualityParam = parameters.getRawParameterValue ( "wsQuality"        );
+    foldbackQualityParam  = parameters.getRawParameterValue ( "foldbackQuality"  );
     
     // Formant Params
     formantMorphParam = parameters.getRawParameterValue  ( "formantMorph"  );
@@ -134,10 +213,17 @@ parameters(*this, nullptr, "ParameterTree",
     haasWidthParam = parameters.getRawParameterValue ( "haasWidth" );
     
     // Filter Params
-    svFilterCutoffParam = parameters.getRawParameterValue ( "svFiltCutoff" );
-    svFilterResParam    = parameters.getRawParameterValue ( "svFiltRes"    );
-    svFilterTypeParam   = parameters.getRawParameterValue ( "svFiltType"   );
-    svFilterPolesParam  = parameters.getRawParameterValue ( "svFiltPoles"  );
+    svFilterCutoffParam    = parameters.getRawParameterValue ( "svFiltCutoff"      );
+    svFilterResParam       = parameters.getRawParameterValue ( "svFiltRes"         );
+    svFilterTypeParam      = parameters.getRawParameterValue ( "svFiltType"        );
+    svFilterPolesParam     = parameters.getRawParameterValue ( "svFiltPoles"       );
+    filterControlRateParam = parameters.getRawParameterValue ( "filterControlRate" );
+    
+    // Modulation targets
+    waveShapeAmountModSlot = modulation->addTarget ( "wsAmt"        );
+    formantMorphModSlot    = modulation->addTarget ( "formantMorph" );
+    svFilterCutoffModSlot  = modulation->addTarget ( "svFiltCutoff" );
+    delayFXTimeModSlot     = modulation->addTarget ( "delayFXTime"  );
     
     // Sensor On/Off Params
     accelXOnOffParam = parameters.getRawParameterValue ( "accelXOnOff" );
@@ -153,10 +239,49 @@ parameters(*this, nullptr, "ParameterTree",
     touchZOnOffParam = parameters.getRawParameterValue ( "touchZOnOff" );
     
     distanceOnOffParam = parameters.getRawParameterValue ( "distOnOff" );
+    
+    // Sensor Link
+    sensorBufferMsParam  = parameters.getRawParameterValue ( "sensorBufferMs"  );
+    sensorTimeoutMsParam = parameters.getRawParameterValue ( "sensorTimeoutMs" );
+    
+    // The receiver runs whether or not audio does, so these don't wait for processBlock
+    osc->setBufferDelay  ( *sensorBufferMsParam  );
+    osc->setStaleTimeout ( *sensorTimeoutMsParam );
+    
+    parameters.addParameterListener ( "sensorBufferMs",  this );
+    parameters.addParameterListener ( "sensorTimeoutMs", this );
+    
+    // Polls for latency changes made on the audio thread
+    startTimerHz ( 10 );
 }
 
 BassOnboardAudioProcessor::~BassOnboardAudioProcessor()
 {
+    stopTimer();
+    
+    parameters.removeParameterListener ( "sensorBufferMs",  this );
+    parameters.removeParameterListener ( "sensorTimeoutMs", this );
+}
+
+
+/// Message thread: reports a latency change picked up by processBlock to the host
+void BassOnboardAudioProcessor::timerCallback()
+{
+    int latency = pendingLatency.load ( std::memory_order_relaxed );
+    
+    if (latency != getLatencySamples())
+        setLatencySamples ( latency );
+}
+
+
+/// Hands the sensor link params to the OSC receiver as they change, on whichever thread changed them
+void BassOnboardAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    // Both setters are single atomic stores, so any thread will do
+    if (parameterID == "sensorBufferMs")
+        osc->setBufferDelay ( newValue );
+    else if (parameterID == "sensorTimeoutMs")
+        osc->setStaleTimeout ( newValue );
 }
 
 //==============================================================================
@@ -229,9 +354,18 @@ void BassOnboardAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     
     spec.maximumBlockSize = samplesPerBlock;
     spec.sampleRate       = sampleRate;
+    spec.numChannels      = getTotalNumOutputChannels();
+    
+    // Everything up to the Haas widener runs on a single mono channel
+    juce::dsp::ProcessSpec monoSpec = spec;
+    monoSpec.numChannels            = 1;
+    
+    // Effects bus: allocated here so processBlock never touches the heap
+    effectsBuffer.setSize ( 1, samplesPerBlock );
+    effectsBuffer.clear   ();
     
     // Gains
-    inGain.prepare                ( spec );
+    inGain.prepare                ( monoSpec );
     inGain.reset                  ( );
     inGain.setRampDurationSeconds ( 0.01f );
     
@@ -240,32 +374,52 @@ void BassOnboardAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     outGain.setRampDurationSeconds ( 0.01f );
     
     // Distortion
-    waveShaper->setSampleRate ( sampleRate );
-    foldback->setSampleRate   ( sampleRate );
-    bitCrush->prepare         ( sampleRate );
+    distortion->prepare              ( monoSpec );
+    distortion->setOversampling      ( static_cast<int>(*distOversamplingParam) );
+    distortion->setCrushAntiAliasing ( static_cast<int>(*bitCrushQualityParam) );
+    
+    pendingLatency.store ( distortion->getLatencySamples(), std::memory_order_relaxed );
+    setLatencySamples    ( distortion->getLatencySamples() );
+    
+    // Filter and formant coefficient update period
+    filterControlInterval = ControlRateFilter::getControlIntervalForIndex ( static_cast<int>(*filterControlRateParam) );
     
     // Formant
-    formant->prepare ( spec );
+    formant->prepare            ( monoSpec );
+    formant->setControlInterval ( filterControlInterval );
+    
+    // Modulation
+    modulation->prepare ( sampleRate );
     
     // Delays
-    delayFX.prepare   ( spec );
-    haasDelay.prepare ( spec );
+    delayFX.prepare   ( monoSpec );
+    haasDelay.prepare ( monoSpec );
     delayFX.reset   ();
     haasDelay.reset ();
     
     delayFXTimeSmooth.reset  ( sampleRate, 0.1f  );
     delayFXFdbckSmooth.reset ( sampleRate, 0.01f );
+    delayFXDryWetSmooth.reset ( sampleRate, 0.01f );
+    
+    delayWetBuffer.setSize ( 1, samplesPerBlock );
+    delayWetBuffer.clear   ();
     haasSmooth.reset         ( sampleRate, 0.01f );
     
     delayFXTimeSmooth.setTargetValue  ( 0.0f );
     delayFXFdbckSmooth.setTargetValue ( 0.0f );
+    delayFXDryWetSmooth.setTargetValue ( 0.0f );
     haasSmooth.setTargetValue         ( 0.0f );
     
+    delayFXBypassed = false;
+    
     // Filter
-    svFilter1.prepare ( spec );
-    svFilter2.prepare ( spec );
-    svFilter1.reset   ();
-    svFilter2.reset   ();
+    svFilter1.prepare ( monoSpec );
+    svFilter2.prepare ( monoSpec );
+    
+    svFilter1.setControlInterval ( filterControlInterval );
+    svFilter2.setControlInterval ( filterControlInterval );
+    
+    svFilter2Active = false;
     
     svFilterCutoffSmooth.reset ( sampleRate, 0.01f );
     svFilterResSmooth.reset    ( sampleRate, 0.01f );
@@ -289,6 +443,8 @@ bool BassOnboardAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 
 void BassOnboardAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    AllocationTracker::ScopedAudioThreadCheck allocationCheck;
+    
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -296,59 +452,91 @@ void BassOnboardAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
-    // Audio input to buffer
-//    auto* leftChannel  = buffer.getWritePointer ( 0 );
-//    auto* rightChannel = buffer.getWritePointer ( 1 );
+    // Copy the mono input into the preallocated Effects buffer (avoidReallocating keeps this off the heap)
+    int numSamples = buffer.getNumSamples();
+    
+    effectsBuffer.setSize  ( 1, numSamples, false, false, true );
+    effectsBuffer.copyFrom ( 0, 0, buffer, 0, 0, numSamples );
     
     // Create the AudioBlock for DSP widgets
-    juce::dsp::AudioBlock<float> sampleBlock ( buffer );
+    juce::dsp::AudioBlock<float> effectsBlock ( effectsBuffer );
+    
+    // LFO modulation for this block
+    modulation->process ( numSamples );
     
     // Apply Input Gain
     inGain.setGainDecibels ( *inGainDBParam );
-    inGain.process         ( juce::dsp::ProcessContextReplacing<float>( sampleBlock ) );
+    inGain.process         ( juce::dsp::ProcessContextReplacing<float>( effectsBlock ) );
     
-    // Create Effects buffer
-    juce::AudioBuffer<float> effectsBuffer;
-    effectsBuffer.clear();
-    effectsBuffer.makeCopyOf ( buffer );
+    // Distortions: waveshaper -> foldback -> bitcrusher in one fused pass
+    distortion->setOversampling      ( static_cast<int>(*distOversamplingParam) );
+    distortion->setAntiAliasing      ( static_cast<int>(*waveShapeQualityParam), static_cast<int>(*foldbackQualityParam) );
+    distortion->setWaveshapeCurve    ( static_cast<int>(*waveShapeCurveParam) );
+    distortion->setBitDepth          ( *bitDepthParam, static_cast<int>(*bitCrushDitherParam) );
+    distortion->setCrushAntiAliasing ( static_cast<int>(*bitCrushQualityParam) );
     
-//    int effectsSize = effectsBuffer.getNumSamples ();
+    // setLatencySamples( ) notifies the host, which isn't realtime safe: hand the change to timerCallback( )
+    pendingLatency.store ( distortion->getLatencySamples(), std::memory_order_relaxed );
     
-    //auto* writeL = effectsBuffer.getWritePointer ( 0 );
-    //auto* writeR = effectsBuffer.getWritePointer ( 1 );
+    distortion->processBuffer ( effectsBuffer,
+                                modulation->getValue ( waveShapeAmountModSlot ), *waveShapeDryWetParam,
+                                *foldbackAmountParam,  *foldbackDryWetParam,
+                                *bitCrushAmountParam,  *bitCrushDryWetParam );
     
-    // Distortions
-    waveShaper->processWaveshapeBuffer ( effectsBuffer, *waveShapeAmountParam, *waveShapeDryWetParam );
-    foldback->processFoldbackBuffer    ( effectsBuffer, *foldbackAmountParam,  *foldbackDryWetParam  );
-    bitCrush->processBuffer            ( effectsBuffer, *bitCrushAmountParam,  *bitCrushDryWetParam  );
+    // Filter and formant coefficient update period
+    int newFilterInterval = ControlRateFilter::getControlIntervalForIndex ( static_cast<int>(*filterControlRateParam) );
+    
+    if (newFilterInterval != filterControlInterval)
+    {
+        filterControlInterval = newFilterInterval;
+        
+        svFilter1.setControlInterval ( filterControlInterval );
+        svFilter2.setControlInterval ( filterControlInterval );
+        formant->setControlInterval  ( filterControlInterval );
+    }
     
     // Formant
-    formant->processBuffer ( effectsBuffer, *formantMorphParam, *formantDryWetParam );
+    formant->processBuffer ( effectsBuffer, modulation->getValue ( formantMorphModSlot ), *formantDryWetParam );
     
     // Delay
-    delayFXTimeSmooth.setTargetValue  ( *delayFXTimeParam  );
-    delayFXFdbckSmooth.setTargetValue ( *delayFXFdbckParam );
-
-    for (int sample = 0; sample < effectsBuffer.getNumSamples(); sample++)
+    delayFXTimeSmooth.setTargetValue   ( modulation->getValue ( delayFXTimeModSlot ) );
+    delayFXFdbckSmooth.setTargetValue  ( *delayFXFdbckParam  );
+    delayFXDryWetSmooth.setTargetValue ( *delayFXDryWetParam );
+    
+    auto* monoChan = effectsBuffer.getWritePointer ( 0 );
+    
+    // Fully dry: the delay runs until the dry/wet ramp has faded its tail out, then stops
+    if (DryWet::isFullyDry ( delayFXDryWetSmooth ))
     {
-        auto* leftChan  = effectsBuffer.getWritePointer ( 0 );
-        auto* rightChan = effectsBuffer.getWritePointer ( 1 );
-
-        float delayTimeSamples = delayFXTimeSmooth.getNextValue() * getSampleRate();   // 1 sec max delay (((Increase?)))
-        float feedbackAmt      = delayFXFdbckSmooth.getNextValue();
-
-        float delaySampleL = delayFX.popSample ( 0, delayTimeSamples, true );
-        float delaySampleR = delayFX.popSample ( 1, delayTimeSamples, true );
-
-        delayFX.pushSample ( 0, leftChan[sample]  + (delaySampleL * feedbackAmt) );
-        delayFX.pushSample ( 1, rightChan[sample] + (delaySampleR * feedbackAmt) );
-
-        leftChan[sample]  = delayFXDryWet->dryWetMixEqualPowerBySample ( leftChan[sample],
-                                                                         delaySampleL,
-                                                                        *delayFXDryWetParam );
-        rightChan[sample] = delayFXDryWet->dryWetMixEqualPowerBySample ( rightChan[sample],
-                                                                         delaySampleR,
-                                                                        *delayFXDryWetParam );
+        delayFXTimeSmooth.skip  ( numSamples );
+        delayFXFdbckSmooth.skip ( numSamples );
+        
+        delayFXBypassed = true;
+    }
+    else
+    {
+        // Coming back in: clear the old tail so it doesn't burst out as the dry/wet ramps up
+        if (delayFXBypassed)
+        {
+            delayFX.reset();
+            delayFXBypassed = false;
+        }
+        
+        delayWetBuffer.setSize ( 1, numSamples, false, false, true );
+        
+        auto* delayWet = delayWetBuffer.getWritePointer ( 0 );
+        
+        for (int sample = 0; sample < numSamples; sample++)
+        {
+            float delayTimeSamples = delayFXTimeSmooth.getNextValue() * getSampleRate();   // 1 sec max delay (((Increase?)))
+            float feedbackAmt      = delayFXFdbckSmooth.getNextValue();
+            
+            delayWet[sample] = delayFX.popSample ( 0, delayTimeSamples, true );
+            
+            delayFX.pushSample ( 0, monoChan[sample] + (delayWet[sample] * feedbackAmt) );
+        }
+        
+        delayFXDryWet->dryWetMixEqualPowerBlock ( monoChan, delayWet, monoChan, numSamples, delayFXDryWetSmooth );
     }
     
     
@@ -374,60 +562,62 @@ void BassOnboardAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             break;
     }
 
-    svFilterCutoffSmooth.setTargetValue ( *svFilterCutoffParam );
+    svFilterCutoffSmooth.setTargetValue ( modulation->getValue ( svFilterCutoffModSlot ) );
     svFilterResSmooth.setTargetValue    ( *svFilterResParam    );
     
     
-    for (int sample = 0; sample < effectsBuffer.getNumSamples(); sample++)
+    // The second stage sits idle in 1-pole mode: bring it back with a clear state, due for fresh coefficients
+    bool twoPole = static_cast<int>(*svFilterPolesParam) == 1;
+    
+    if (twoPole && ! svFilter2Active)
+        svFilter2.reset();
+    
+    svFilter2Active = twoPole;
+    
+    for (int sample = 0; sample < numSamples; sample++)
     {
-        auto* leftChan  = effectsBuffer.getWritePointer ( 0 );
-        auto* rightChan = effectsBuffer.getWritePointer ( 1 );
-
-        float cutoffFreq = svFilterCutoffSmooth.getNextValue();
-        float cutoffRes  = svFilterResSmooth.getNextValue();
-
-        svFilter1.setCutoffFrequency ( cutoffFreq );
-        svFilter2.setCutoffFrequency ( cutoffFreq );
-        svFilter1.setResonance       ( cutoffRes  );
-        svFilter2.setResonance       ( cutoffRes  );
-
-        switch ( static_cast<int>(*svFilterPolesParam) )
+        // Coefficients are updated at control rate and ramped in between
+        if (svFilter1.isUpdateDue() || ( twoPole && svFilter2.isUpdateDue() ))
         {
-            case 0 :
-                leftChan[sample]  = svFilter1.processSample ( 0, leftChan[sample]  );
-                rightChan[sample] = svFilter1.processSample ( 1, rightChan[sample] );
-                break;
-            case 1 :
-                leftChan[sample]  = svFilter2.processSample ( 0, svFilter1.processSample ( 0, leftChan[sample]  ) );
-                rightChan[sample] = svFilter2.processSample ( 1, svFilter1.processSample ( 1, rightChan[sample] ) );
-                break;
-            default:
-                leftChan[sample]  = svFilter1.processSample ( 0, leftChan[sample]  );
-                rightChan[sample] = svFilter1.processSample ( 1, rightChan[sample] );
-                break;
+            float cutoffFreq = svFilterCutoffSmooth.skip ( filterControlInterval );
+            float cutoffRes  = svFilterResSmooth.skip    ( filterControlInterval );
+            
+            svFilter1.setTargets ( cutoffFreq, cutoffRes );
+            
+            if (twoPole)
+                svFilter2.setTargets ( cutoffFreq, cutoffRes );
         }
+
+        if (twoPole)
+            monoChan[sample] = svFilter2.processSample ( svFilter1.processSample ( monoChan[sample] ) );
+        else
+            monoChan[sample] = svFilter1.processSample ( monoChan[sample] );
     }
     
     svFilter1.snapToZero();
     svFilter2.snapToZero();
     
+    // Late stereo split: the mono core feeds both outputs, only L goes through the Haas delay
+    for (int chan = 0; chan < totalNumOutputChannels; chan++)
+        buffer.copyFrom ( chan, 0, effectsBuffer, 0, 0, numSamples );
+    
     // Haas Widener
     haasSmooth.setTargetValue ( *haasWidthParam );
     
-    for (int i = 0; i < effectsBuffer.getNumSamples(); i++)
+    auto* leftChan = buffer.getWritePointer ( 0 );
+    
+    for (int i = 0; i < numSamples; i++)
     {
         float delayInSamples = haasSmooth.getNextValue() * ( 0.03f * getSampleRate() );
-        auto* leftChan       = effectsBuffer.getWritePointer ( 0 );
 
         haasDelay.pushSample ( 0, leftChan[i] );
 
         leftChan[i] = haasDelay.popSample ( 0, delayInSamples, true );
     }
     
-    // Copy FX buffer onto buffer
-    buffer.makeCopyOf ( effectsBuffer );
-    
     // Apply Output Gain
+    juce::dsp::AudioBlock<float> sampleBlock ( buffer );
+    
     outGain.setGainDecibels ( *outGainDBParam );
     outGain.process         ( juce::dsp::ProcessContextReplacing<float>( sampleBlock ) );
 }
@@ -444,6 +634,12 @@ juce::AudioProcessorEditor* BassOnboardAudioProcessor::createEditor()
     //return new GenericAudioProcessorEditor (*this);
 }
 
+/// Returns the OSC receiver. Owned here so sensor data keeps arriving while the editor is closed
+OSCHandler& BassOnboardAudioProcessor::getOSCHandler()
+{
+    return *osc;
+}
+
 //==============================================================================
 void BassOnboardAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
@@ -10,15 +10,19 @@
 
 #include <JuceHeader.h>
 #include "DryWet.h"
-#include "WaveShaper.h"
-#include "FoldbackDistortion.h"
-#include "BitCrusher.h"
+#include "DistortionChain.h"
 #include "FormantFilter.h"
+#include "ControlRateFilter.h"
+#include "AllocationTracker.h"
+#include "ModulationEngine.h"
+#include "OSCHandling.h"
 
 //==============================================================================
 /**
 */
-class BassOnboardAudioProcessor  : public juce::AudioProcessor
+class BassOnboardAudioProcessor  : public juce::AudioProcessor,
+                                   private juce::Timer,
+                                   private juce::AudioProcessorValueTreeState::Listener
 {
 public:
     //==============================================================================
@@ -60,8 +64,17 @@ public:
     
     // APVTS Parameters instalnce
     juce::AudioProcessorValueTreeState parameters;
+    
+    /// Returns the OSC receiver. Owned here so sensor data keeps arriving while the editor is closed
+    OSCHandler& getOSCHandler();
 
 private:
+    /// Message thread: reports a latency change picked up by processBlock to the host
+    void timerCallback() override;
+    
+    /// Hands the sensor link params to the OSC receiver as they change, on whichever thread changed them
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    
     // Gain Params
     std::atomic<float>* inGainDBParam;
     std::atomic<float>* outGainDBParam;
@@ -73,6 +86,13 @@ private:
     std::atomic<float>* foldbackDryWetParam;
     std::atomic<float>* bitCrushAmountParam;
     std::atomic<float>* bitCrushDryWetParam;
+    std::atomic<float>* bitDepthParam;
+    std::atomic<float>* bitCrushDitherParam;
+    std::atomic<float>* bitCrushQualityParam;
+    std::atomic<float>* distOversamplingParam;
+    std::atomic<float>* waveShapeCurveParam;
+    std::atomic<float>* waveShapeQualityParam;
+    std::atomic<float>* foldbackQualityParam;
     
     // Formant Params
     std::atomic<float>* formantMorphParam;
@@ -86,6 +106,10 @@ private:
     
     juce::SmoothedValue<float> delayFXTimeSmooth;
     juce::SmoothedValue<float> delayFXFdbckSmooth;
+    juce::SmoothedValue<float> delayFXDryWetSmooth;
+    juce::AudioBuffer<float>   delayWetBuffer;
+    
+    bool delayFXBypassed = false;
     juce::SmoothedValue<float> haasSmooth;
     
     // Filter Params
@@ -93,6 +117,7 @@ private:
     std::atomic<float>* svFilterResParam;
     std::atomic<float>* svFilterTypeParam;
     std::atomic<float>* svFilterPolesParam;
+    std::atomic<float>* filterControlRateParam;
     
     juce::SmoothedValue<float> svFilterCutoffSmooth;
     juce::SmoothedValue<float> svFilterResSmooth;
@@ -112,15 +137,20 @@ private:
     
     std::atomic<float>* distanceOnOffParam;
     
+    // Sensor Link
+    std::atomic<float>* sensorBufferMsParam;
+    std::atomic<float>* sensorTimeoutMsParam;
+    
+    // Effects bus, sized in prepareToPlay
+    juce::AudioBuffer<float> effectsBuffer;
+    
     // Gain
     juce::dsp::Gain<float> inGain;
     juce::dsp::Gain<float> outGain;
     
     // FX
-    std::unique_ptr<WaveShaper>         waveShaper;
-    std::unique_ptr<FoldbackDistortion> foldback;
-    std::unique_ptr<BitCrusher>         bitCrush;
-    std::unique_ptr<FormantFilter>      formant;
+    std::unique_ptr<DistortionChain> distortion;
+    std::unique_ptr<FormantFilter>   formant;
     
     juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayFX   { 192000 };
     juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> haasDelay { 192000 };
@@ -128,9 +158,29 @@ private:
     
     std::unique_ptr<DryWet> delayFXDryWet;
     
+    // LFO modulation and the slots of its targets
+    std::unique_ptr<ModulationEngine> modulation;
+    
+    int waveShapeAmountModSlot;
+    int formantMorphModSlot;
+    int svFilterCutoffModSlot;
+    int delayFXTimeModSlot;
+    
+    // Arduino sensor input
+    std::unique_ptr<OSCHandler> osc;
+    
     // Filter
-    juce::dsp::StateVariableTPTFilter<float> svFilter1;
-    juce::dsp::StateVariableTPTFilter<float> svFilter2;
+    ControlRateFilter svFilter1;
+    ControlRateFilter svFilter2;
+    
+    /// Samples between filter and formant coefficient updates (cutoff/resonance are ramped in between), from "filterControlRate"
+    int filterControlInterval = 16;
+    
+    /// False while 1-pole mode leaves svFilter2 unprocessed
+    bool svFilter2Active = false;
+    
+    // Latency of the current distortion settings, written by processBlock and reported by timerCallback( )
+    std::atomic<int> pendingLatency { 0 };
     
     
     //==============================================================================
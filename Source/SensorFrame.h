@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    SensorFrame.h
+    Created: 17 Oct 2026 4:52:37pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Binary sensor frame sent by the Arduino's sendBinaryFrame( ) on UDP port 9002.
+
+ One fixed-layout, little-endian datagram per loop( ) instead of an OSC bundle with
+ 26 padded address strings (about 1 KB for 104 bytes of values):
+
+     offset  size  field
+          0     4  magic "BOSF"
+          4     2  version
+          6     2  number of values (26)
+          8     4  sequence number, +1 per frame
+         12     4  device timestamp, micros( )
+         16   104  values, float32 in OSCHandler::Slot order
+        120     4  button mask, bit per button held (sensor 0-9, filter 10-13, encoder 14-15)
+
+ 124 bytes in all. View reads the fields straight out of the received datagram, no copy.
+ */
+namespace SensorFrame
+{
+    constexpr juce::uint32 magic      = 0x46534f42;     // "BOSF" read little-endian
+    constexpr juce::uint16 version    = 1;
+    constexpr int          numValues  = 26;
+    constexpr int          headerSize = 16;
+    constexpr int          frameSize  = headerSize + numValues * 4 + 4;
+
+    /// Read-only view of one frame in a datagram buffer. The buffer must outlive the View
+    class View
+    {
+    public:
+        View (const void* data, int numBytes) :
+            bytes ( static_cast<const char*>( data ) ),
+            size  ( numBytes )
+        {}
+
+        /// Returns true if the datagram is a complete frame of this version
+        bool isValid() const
+        {
+            return size >= frameSize
+                && readUInt32 ( 0 ) == magic
+                && juce::ByteOrder::littleEndianShort ( bytes + 4 ) == version
+                && juce::ByteOrder::littleEndianShort ( bytes + 6 ) == numValues;
+        }
+
+        /// Returns the frame's sequence number
+        juce::uint32 getSequence() const     { return readUInt32 ( 8 ); }
+
+        /// Returns the Arduino's micros( ) when the frame was sent
+        juce::uint32 getTimestamp() const    { return readUInt32 ( 12 ); }
+
+        /// Returns value index, 0 to numValues - 1
+        float getValue(int index) const
+        {
+            jassert ( juce::isPositiveAndBelow ( index, numValues ) );
+
+            juce::uint32 bits = readUInt32 ( headerSize + index * 4 );
+
+            float value;
+            std::memcpy ( &value, &bits, sizeof ( value ) );
+
+            return value;
+        }
+
+        /// Returns the held buttons, one bit each
+        juce::uint32 getButtonMask() const   { return readUInt32 ( headerSize + numValues * 4 ); }
+
+    private:
+        juce::uint32 readUInt32(int offset) const
+        {
+            return juce::ByteOrder::littleEndianInt ( bytes + offset );
+        }
+
+        const char* bytes;
+        int         size;
+    };
+}
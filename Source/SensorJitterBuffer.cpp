@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    SensorJitterBuffer.cpp
+    Created: 17 Oct 2026 5:34:18pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#include "SensorJitterBuffer.h"
+
+namespace
+{
+    // How far the device clock offset may creep forward per packet (covers ~200 ppm of crystal drift at 100 packets/s)
+    constexpr double offsetCreepMs = 0.002;
+
+    // A device clock jump larger than this is a reboot or a long dropout: re-anchor instead of trusting it
+    constexpr double maxDeviceJumpMs = 1000.0;
+}
+
+SensorJitterBuffer::SensorJitterBuffer(int numValuesIn, int numContinuousIn) :
+    numValues        ( numValuesIn     ),
+    numContinuous    ( numContinuousIn ),
+    numPushed        ( 0               ),
+    delay            ( 0.0f            ),
+    hasDeviceClock   ( false           ),
+    lastDeviceMicros ( 0               ),
+    deviceMs         ( 0.0             ),
+    deviceOffsetMs   ( 0.0             ),
+    newestTime       ( std::numeric_limits<double>::lowest() )
+{
+    jassert ( numValues <= maxValues && numContinuous <= numValues );
+}
+
+SensorJitterBuffer::~SensorJitterBuffer() {}
+
+
+/// Sets how far behind real time read( ) looks, in ms
+void SensorJitterBuffer::setDelay(float delayMs)
+{
+    delay.store ( juce::jmax ( 0.0f, delayMs ), std::memory_order_relaxed );
+}
+
+
+/// Returns how far behind real time read( ) looks, in ms
+float SensorJitterBuffer::getDelay() const
+{
+    return delay.load ( std::memory_order_relaxed );
+}
+
+
+/// Maps a device micros( ) timestamp onto the host clock. Writer thread only
+double SensorJitterBuffer::deviceToHostTime(juce::uint32 deviceMicros, double arrivalMs)
+{
+    // Signed difference, so micros( ) wrapping every ~71 minutes doesn't matter
+    double deltaMs = static_cast<juce::int32>( deviceMicros - lastDeviceMicros ) / 1000.0;
+
+    if (! hasDeviceClock || isDeviceClockJump ( deviceMicros ))
+    {
+        hasDeviceClock   = true;
+        lastDeviceMicros = deviceMicros;
+        deviceOffsetMs   = arrivalMs - deviceMs;
+
+        return arrivalMs;
+    }
+
+    // Reordered packet: time it, but don't move the device clock back
+    if (deltaMs < 0.0)
+        return deviceMs + deltaMs + deviceOffsetMs;
+
+    deviceMs         += deltaMs;
+    lastDeviceMicros  = deviceMicros;
+
+    // The least-delayed packet sets the offset; creeping forward keeps clock drift from stranding it
+    deviceOffsetMs = juce::jmin ( arrivalMs - deviceMs, deviceOffsetMs + offsetCreepMs );
+
+    return deviceMs + deviceOffsetMs;
+}
+
+
+/// Returns true if deviceToHostTime( ) would re-anchor on this timestamp: the device rebooted or went quiet. Writer thread only
+bool SensorJitterBuffer::isDeviceClockJump(juce::uint32 deviceMicros) const
+{
+    double deltaMs = static_cast<juce::int32>( deviceMicros - lastDeviceMicros ) / 1000.0;
+
+    return hasDeviceClock && std::abs ( deltaMs ) > maxDeviceJumpMs;
+}
+
+
+/// Adds an update stamped timeMs on the host clock. Updates older than the newest are dropped. Writer thread only
+void SensorJitterBuffer::push(const float* values, double timeMs)
+{
+    if (timeMs < newestTime)
+        return;
+
+    newestTime = timeMs;
+
+    juce::uint32 count    = numPushed.load ( std::memory_order_relaxed );
+    Entry&       entry    = entries[count % capacity];
+    juce::uint32 sequence = entry.sequence.load ( std::memory_order_relaxed );
+
+    // Odd while writing, so readers know to retry
+    entry.sequence.store ( sequence + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence ( std::memory_order_release );
+
+    entry.time.store ( timeMs, std::memory_order_relaxed );
+
+    for (int i = 0; i < numValues; i++)
+        entry.values[i].store ( values[i], std::memory_order_relaxed );
+
+    entry.sequence.store ( sequence + 2, std::memory_order_release );
+    numPushed.store      ( count + 1,    std::memory_order_release );
+}
+
+
+/// Writes the values at timeMs - delay into valuesOut. Returns false (leaving valuesOut alone) if there's nothing to read
+bool SensorJitterBuffer::read(double timeMs, float* valuesOut) const
+{
+    double target = timeMs - delay.load ( std::memory_order_relaxed );
+
+    float  older[maxValues];
+    float  newer[maxValues];
+    double olderTime;
+    double newerTime;
+
+    // Only fails if the writer laps the reader mid-read, so a few tries is plenty
+    for (int attempt = 0; attempt < 4; attempt++)
+    {
+        juce::uint32 count = numPushed.load ( std::memory_order_acquire );
+
+        if (count == 0)
+            return false;
+
+        // One entry of slack: the writer may already be filling the slot after the newest
+        juce::uint32 oldest = count > capacity - 1 ? count - ( capacity - 1 ) : 0;
+        juce::uint32 index  = count - 1;
+
+        // Newest update at or before the target
+        while (index > oldest && entries[index % capacity].time.load ( std::memory_order_relaxed ) > target)
+            --index;
+
+        if (! readEntry ( entries[index % capacity], older, olderTime ))
+            continue;
+
+        // Target is past the newest update (or before the oldest still held): hold it
+        if (index == count - 1 || olderTime >= target)
+        {
+            std::copy ( older, older + numValues, valuesOut );
+            return true;
+        }
+
+        if (! readEntry ( entries[( index + 1 ) % capacity], newer, newerTime ) || newerTime < target)
+            continue;
+
+        float fraction = static_cast<float>( ( target - olderTime ) / ( newerTime - olderTime ) );
+
+        for (int i = 0; i < numContinuous; i++)
+            valuesOut[i] = older[i] + fraction * ( newer[i] - older[i] );
+
+        // Switches and counters step when the update that changed them is reached
+        std::copy ( older + numContinuous, older + numValues, valuesOut + numContinuous );
+
+        return true;
+    }
+
+    return false;
+}
+
+
+/// Copies an entry out. Returns false if it was being written or got overwritten mid-copy
+bool SensorJitterBuffer::readEntry(const Entry &entry, float* dest, double &time) const
+{
+    juce::uint32 before = entry.sequence.load ( std::memory_order_acquire );
+
+    if (( before & 1 ) != 0)
+        return false;
+
+    time = entry.time.load ( std::memory_order_relaxed );
+
+    for (int i = 0; i < numValues; i++)
+        dest[i] = entry.values[i].load ( std::memory_order_relaxed );
+
+    std::atomic_thread_fence ( std::memory_order_acquire );
+
+    return entry.sequence.load ( std::memory_order_relaxed ) == before;
+}
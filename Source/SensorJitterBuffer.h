@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    SensorJitterBuffer.h
+    Created: 17 Oct 2026 5:34:18pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Timestamped ring of sensor updates, read back a fixed delay behind real time.
+
+ Packets from the Arduino arrive with WiFi jitter, so the last value received moves in
+ uneven steps. Reading delayMs in the past instead lands between two updates that have
+ both already arrived, and the continuous sensors are interpolated linearly between
+ them: a late packet no longer shows up as a step. The delay is the latency paid for
+ that, 0 reads the newest update as before.
+
+ Updates are timed on the host clock (Time::getMillisecondCounterHiRes( )). Binary
+ frames carry the Arduino's micros( ), which is mapped onto the host clock through the
+ least-delayed packet seen, so the spacing of those updates is the spacing they were
+ sent with rather than the spacing they arrived with. Arrival times and mapped device times
+ can't be mixed: the mapped ones run a few ms behind, so updates stamped one way would drop
+ the other as out of order. Push updates from one source only.
+
+ One writer thread at a time; any number of lock-free readers. Each entry is its own
+ small seqlock.
+ */
+class SensorJitterBuffer
+{
+public:
+    /// numValues per update, of which the first numContinuous are interpolated (the rest are held)
+    SensorJitterBuffer(int numValues, int numContinuous);
+    ~SensorJitterBuffer();
+
+    /// Sets how far behind real time read( ) looks, in ms
+    void setDelay(float delayMs);
+
+    /// Returns how far behind real time read( ) looks, in ms
+    float getDelay() const;
+
+    /// Maps a device micros( ) timestamp onto the host clock. Writer thread only
+    double deviceToHostTime(juce::uint32 deviceMicros, double arrivalMs);
+
+    /// Returns true if deviceToHostTime( ) would re-anchor on this timestamp: the device rebooted or went quiet. Writer thread only
+    bool isDeviceClockJump(juce::uint32 deviceMicros) const;
+
+    /// Adds an update stamped timeMs on the host clock. Updates older than the newest are dropped. Writer thread only
+    void push(const float* values, double timeMs);
+
+    /// Writes the values at timeMs - delay into valuesOut. Returns false (leaving valuesOut alone) if there's nothing to read
+    bool read(double timeMs, float* valuesOut) const;
+
+private:
+    static constexpr int capacity  = 64;    // ~300 ms of updates at the sketch's loop rate, over the longest delay
+    static constexpr int maxValues = 32;
+
+    struct Entry
+    {
+        std::atomic<juce::uint32> sequence { 0 };
+        std::atomic<double>       time     { 0.0 };
+        std::atomic<float>        values[maxValues];
+    };
+
+    /// Copies an entry out. Returns false if it was being written or got overwritten mid-copy
+    bool readEntry(const Entry& entry, float* dest, double& time) const;
+
+    const int numValues;
+    const int numContinuous;
+
+    Entry                     entries[capacity];
+    std::atomic<juce::uint32> numPushed;
+    std::atomic<float>        delay;
+
+    // Writer-side device clock mapping
+    bool         hasDeviceClock;
+    juce::uint32 lastDeviceMicros;
+    double       deviceMs;
+    double       deviceOffsetMs;
+    double       newestTime;
+};
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    ShaperTables.cpp
+    Created: 17 Oct 2026 3:28:52pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#include "ShaperTables.h"
+
+ShaperTables::ShaperTables()
+{
+    for (int curveIndex = 0; curveIndex < numCurves; curveIndex++)
+    {
+        auto& curve    = curves[curveIndex];
+        auto& integral = integrals[curveIndex];
+        
+        curve.resize    ( tableSize );
+        integral.resize ( tableSize );
+        
+        for (int i = 0; i < tableSize; i++)
+            curve[i] = static_cast<float>( evaluate ( curveIndex, static_cast<double>( i ) / pointsPerUnit - inputRange ) );
+        
+        // Trapezoids are exact for the linearly interpolated curve
+        integral[0] = 0.0;
+        
+        for (int i = 1; i < tableSize; i++)
+            integral[i] = integral[i - 1] + 0.5 * ( static_cast<double>( curve[i - 1] ) + curve[i] ) / pointsPerUnit;
+    }
+}
+
+ShaperTables::~ShaperTables() {}
+
+
+/// Curve names in Curve order, for the parameter choices
+juce::StringArray ShaperTables::getCurveNames()
+{
+    return { "Tanh", "Arctan", "Tube", "Diode", "Hard Clip" };
+}
+
+
+/// Returns the transfer table for a curve
+const float* ShaperTables::getCurve(int curveIndex) const
+{
+    return curves[juce::jlimit ( 0, numCurves - 1, curveIndex )].data();
+}
+
+
+/// Returns the integral table for a curve
+const double* ShaperTables::getIntegral(int curveIndex) const
+{
+    return integrals[juce::jlimit ( 0, numCurves - 1, curveIndex )].data();
+}
+
+
+/// The analytic transfer curves the tables are built from
+double ShaperTables::evaluate(int curveIndex, double x)
+{
+    switch (curveIndex)
+    {
+        case arctanCurve:
+            return std::atan ( x ) * 2.0 / juce::MathConstants<double>::pi;
+            
+        case tubeCurve:
+        {
+            // Biased tanh: the positive swing clips lower than the negative, adding even harmonics (and some DC)
+            const double bias = 0.3;
+            return ( std::tanh ( x + bias ) - std::tanh ( bias ) ) / ( 1.0 + std::tanh ( bias ) );
+        }
+            
+        case diodeCurve:
+            // Exponential knee of a diode pair
+            return x >= 0.0 ? 1.0 - std::exp ( -x ) : std::exp ( x ) - 1.0;
+            
+        case hardClipCurve:
+            return juce::jlimit ( -1.0, 1.0, x );
+            
+        case tanhCurve:
+        default:
+            return std::tanh ( x );
+    }
+}
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    ShaperTables.h
+    Created: 17 Oct 2026 3:28:52pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Precomputed waveshaper transfer curves, shared by every WaveShaper through a
+ juce::SharedResourcePointer so they are only built once per process.
+
+ Each curve is tabled over [-inputRange, inputRange] and clamps outside it.
+ Alongside every curve sits its running integral (in double), which is exact for
+ the linearly interpolated curve and lets ADAA work for any curve.
+
+ The tables don't depend on the sample rate. A shaper picks a curve by holding
+ its table pointers, so the per-sample cost is the same for every curve.
+ */
+class ShaperTables
+{
+public:
+    enum Curve
+    {
+        tanhCurve = 0,
+        arctanCurve,
+        tubeCurve,
+        diodeCurve,
+        hardClipCurve,
+        numCurves
+    };
+    
+    ShaperTables();
+    ~ShaperTables();
+    
+    /// Curve names in Curve order, for the parameter choices
+    static juce::StringArray getCurveNames();
+    
+    /// Returns the transfer table for a curve
+    const float* getCurve(int curveIndex) const;
+    
+    /// Returns the integral table for a curve
+    const double* getIntegral(int curveIndex) const;
+    
+    /// Linearly interpolated curve value. Branchless, clamps outside the table
+    static inline float lookup(const float* curve, float x)
+    {
+        float pos   = ( juce::jlimit ( -inputRange, inputRange, x ) + inputRange ) * pointsPerUnit;
+        int   index = juce::jmin ( static_cast<int>( pos ), tableSize - 2 );
+        float frac  = pos - index;
+        
+        return curve[index] + frac * ( curve[index + 1] - curve[index] );
+    }
+    
+    /// Exact integral of the interpolated curve from -inputRange to x, extended linearly outside the table
+    static inline double lookupIntegral(const float* curve, const double* integral, double x)
+    {
+        double clamped = juce::jlimit ( static_cast<double>( -inputRange ), static_cast<double>( inputRange ), x );
+        double pos     = ( clamped + inputRange ) * pointsPerUnit;
+        int    index   = juce::jmin ( static_cast<int>( pos ), tableSize - 2 );
+        double frac    = pos - index;
+        
+        double y0    = curve[index];
+        double slope = curve[index + 1] - y0;
+        double area  = ( y0 + 0.5 * slope * frac ) * frac / pointsPerUnit;
+        
+        // Beyond the table the curve is flat at its edge value
+        double edge  = y0 + slope * frac;
+        
+        return integral[index] + area + edge * ( x - clamped );
+    }
+    
+    // 64 points per unit over +-64: the hard clip knees land on grid points
+    static constexpr float inputRange    = 64.0f;
+    static constexpr int   pointsPerUnit = 64;
+    static constexpr int   tableSize     = 2 * 64 * 64 + 1;
+    
+private:
+    /// The analytic transfer curves the tables are built from
+    static double evaluate(int curveIndex, double x);
+    
+    std::vector<float>  curves[numCurves];
+    std::vector<double> integrals[numCurves];
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ShaperTables)
+};
@@ -12,66 +12,105 @@
 
 
 WaveShaper::WaveShaper() :
-    dryWet ( std::make_unique<DryWet>() )
-{}
+    currentCurve       ( ShaperTables::tanhCurve ),
+    curveTable         ( shaperTables->getCurve    ( ShaperTables::tanhCurve ) ),
+    curveIntegral      ( shaperTables->getIntegral ( ShaperTables::tanhCurve ) ),
+    dryWet             ( std::make_unique<DryWet>() ),
+    useADAA            ( false ),
+    prevDriven         ( 0.0   ),
+    prevAntiderivative ( 0.0   )
+{
+    resetADAA();
+}
 
 WaveShaper::~WaveShaper() {}
 
 void WaveShaper::setSampleRate(float SR)
 {
+    // reset( ) snaps to the target, so keep where the ramps are: an oversampling change mid-glide carries on gliding
+    float amountNow    = wsAmountSmooth.getCurrentValue();
+    float amountTarget = wsAmountSmooth.getTargetValue();
+    float dryWetNow    = dryWetSmooth.getCurrentValue();
+    float dryWetTarget = dryWetSmooth.getTargetValue();
+    
     wsAmountSmooth.reset ( SR, 0.01f );
     dryWetSmooth.reset   ( SR, 0.01f );
     
-    wsAmountSmooth.setTargetValue ( 0.0f );
-    dryWetSmooth.setTargetValue   ( 0.0f );
+    wsAmountSmooth.setCurrentAndTargetValue ( amountNow );
+    dryWetSmooth.setCurrentAndTargetValue   ( dryWetNow );
+    
+    wsAmountSmooth.setTargetValue ( amountTarget );
+    dryWetSmooth.setTargetValue   ( dryWetTarget );
 }
 
 
-juce::AudioBuffer<float> WaveShaper::processWaveshape(juce::AudioBuffer<float>& bufferIn, float wsAmount, float dryWetVal)
+bool WaveShaper::prepareBlock(float wsAmount, float dryWetVal, int numSamples)
 {
-    int numSamples = bufferIn.getNumSamples();
-    
-    auto* leftChan = bufferIn.getWritePointer  ( 0 );
-    auto* rightChan = bufferIn.getWritePointer ( 1 );
-    
-    wsAmountSmooth.setTargetValue ( wsAmount );
+    wsAmountSmooth.setTargetValue ( wsAmount  );
     dryWetSmooth.setTargetValue   ( dryWetVal );
     
-    for (int sample = 0; sample < numSamples; sample++)
+    // Fully dry: skip the stage, just keep the amount smoother in step
+    if (DryWet::isFullyDry ( dryWetSmooth ))
     {
-        float wsAmtSmoothedVal  = wsAmountSmooth.getNextValue();
-        float dryWetSmoothedVal = dryWetSmooth.getNextValue();
-        
-        float wetSampleL = juce::dsp::FastMathApproximations::tanh ( leftChan[sample]  * wsAmtSmoothedVal );
-        float wetSampleR = juce::dsp::FastMathApproximations::tanh ( rightChan[sample] * wsAmtSmoothedVal );
-        
-        leftChan[sample]  = dryWet->dryWetMixEqualPowerBySample ( leftChan[sample],  wetSampleL, dryWetSmoothedVal );
-        rightChan[sample] = dryWet->dryWetMixEqualPowerBySample ( rightChan[sample], wetSampleR, dryWetSmoothedVal );
+        wsAmountSmooth.skip ( numSamples );
+        return false;
     }
     
-    return bufferIn;
+    return true;
 }
 
 
-void WaveShaper::processWaveshapeBuffer(juce::AudioBuffer<float> &bufferIn, float wsAmount, float dryWetVal)
+void WaveShaper::setAntiAliasing(bool shouldUseADAA)
 {
-    int numSamples = bufferIn.getNumSamples();
+    if (shouldUseADAA == useADAA)
+        return;
     
-    auto* leftChan  = bufferIn.getWritePointer ( 0 );
-    auto* rightChan = bufferIn.getWritePointer ( 1 );
+    useADAA = shouldUseADAA;
+    resetADAA();
+}
+
+
+/// Selects the transfer curve, see ShaperTables::Curve
+void WaveShaper::setCurve(int curveIndex)
+{
+    curveIndex = juce::jlimit ( 0, ShaperTables::numCurves - 1, curveIndex );
     
-    wsAmountSmooth.setTargetValue ( wsAmount  );
-    dryWetSmooth.setTargetValue   ( dryWetVal );
+    if (curveIndex == currentCurve)
+        return;
     
-    for (int sample = 0; sample < numSamples; sample++)
-    {
-        float wsAmtSmoothedVal  = wsAmountSmooth.getNextValue();
-        float dryWetSmoothedVal = dryWetSmooth.getNextValue();
-        
-        float wetSampleL = juce::dsp::FastMathApproximations::tanh ( leftChan[sample]  * wsAmtSmoothedVal );
-        float wetSampleR = juce::dsp::FastMathApproximations::tanh ( rightChan[sample] * wsAmtSmoothedVal );
-        
-        leftChan[sample]  = dryWet->dryWetMixEqualPowerBySample ( leftChan[sample],  wetSampleL, dryWetSmoothedVal );
-        rightChan[sample] = dryWet->dryWetMixEqualPowerBySample ( rightChan[sample], wetSampleR, dryWetSmoothedVal );
-    }
+    currentCurve  = curveIndex;
+    curveTable    = shaperTables->getCurve    ( curveIndex );
+    curveIntegral = shaperTables->getIntegral ( curveIndex );
+    
+    resetADAA();
+}
+
+
+/// First-order ADAA: (F(u) - F(uPrev)) / (u - uPrev), F being the tabled integral of the curve
+float WaveShaper::processADAA(float driven)
+{
+    // Double precision: the integral is large at high drive and the difference of two close values cancels badly in float
+    double u              = driven;
+    double antiderivative = ShaperTables::lookupIntegral ( curveTable, curveIntegral, u );
+    double diff           = u - prevDriven;
+    float  wetSample;
+    
+    // Ill-conditioned when the input barely moved: fall back to the curve at the midpoint
+    if (std::abs ( diff ) < 1.0e-5)
+        wetSample = ShaperTables::lookup ( curveTable, static_cast<float>( 0.5 * ( u + prevDriven ) ) );
+    else
+        wetSample = static_cast<float>( ( antiderivative - prevAntiderivative ) / diff );
+    
+    prevDriven         = u;
+    prevAntiderivative = antiderivative;
+    
+    return wetSample;
+}
+
+
+/// Clears the ADAA history
+void WaveShaper::resetADAA()
+{
+    prevDriven         = 0.0;
+    prevAntiderivative = ShaperTables::lookupIntegral ( curveTable, curveIntegral, 0.0 );
 }
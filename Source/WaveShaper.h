@@ -12,6 +12,7 @@
 
 #include <JuceHeader.h>
 #include "DryWet.h"
+#include "ShaperTables.h"
 
 /// Waveshape Distortion Class
 class WaveShaper
@@ -21,17 +22,60 @@ public:
     ~WaveShaper();
     
     void setSampleRate(float SR);
-
-    /// Returns an audio buffer of the dry/wet mixed Waveshaped signal
-    juce::AudioBuffer<float> processWaveshape(juce::AudioBuffer<float>& bufferIn, float wsAmount, float dryWetVal);
     
-    void processWaveshapeBuffer(juce::AudioBuffer<float>& bufferIn, float wsAmount, float dryWetVal);
+    /**
+     Sets the smoothing targets for the next numSamples samples. Returns false if the stage is fully dry,
+     in which case the smoothers are skipped ahead and processSample( ) must not be called for this block
+     */
+    bool prepareBlock(float wsAmount, float dryWetVal, int numSamples);
+    
+    /// Waveshapes and dry/wet mixes a single sample. Call after prepareBlock( ) returned true
+    inline float processSample(float sampleIn);
+    
+    /**
+     Switches between the plain curve and first-order antiderivative anti-aliasing (ADAA).
+     ADAA suppresses most of the aliasing for the cost of two integral lookups per sample;
+     its wet path lags the dry by half a sample
+     */
+    void setAntiAliasing(bool shouldUseADAA);
+    
+    /// Selects the transfer curve, see ShaperTables::Curve
+    void setCurve(int curveIndex);
     
 private:
+    /// First-order ADAA: (F(u) - F(uPrev)) / (u - uPrev), F being the tabled integral of the curve
+    float processADAA(float driven);
+    
+    /// Clears the ADAA history
+    void resetADAA();
+    
+    // Shared transfer curves, and the one in use
+    juce::SharedResourcePointer<ShaperTables> shaperTables;
+    int           currentCurve;
+    const float*  curveTable;
+    const double* curveIntegral;
+    
     // Dry Wet Class Instance
     std::unique_ptr<DryWet> dryWet;
     
     // Member Variables
     juce::SmoothedValue<float> wsAmountSmooth;
     juce::SmoothedValue<float> dryWetSmooth;
+    
+    // ADAA state
+    bool   useADAA;
+    double prevDriven;
+    double prevAntiderivative;
 };
+
+
+inline float WaveShaper::processSample(float sampleIn)
+{
+    float wsAmtSmoothedVal  = wsAmountSmooth.getNextValue();
+    float dryWetSmoothedVal = dryWetSmooth.getNextValue();
+    
+    float wetSample = useADAA ? processADAA ( sampleIn * wsAmtSmoothedVal )
+                              : ShaperTables::lookup ( curveTable, sampleIn * wsAmtSmoothedVal );
+    
+    return dryWet->mixEqualPower ( sampleIn, wetSample, dryWetSmoothedVal );
+}
@@ -19,70 +19,138 @@
 Wavetable::Wavetable() :
     waveTableSize ( 1024     ),
     sampleRate    ( 44100.0f ),
-    frequency     ( 0.0f     ),
     readHeadPos   ( 0.0f     ),
-    increment     ( 1.0f     )
+    increment     ( 1.0f     ),
+    lowerLevel    ( nullptr  ),
+    upperLevel    ( nullptr  ),
+    levelFade     ( 0.0f     )
 {
-    for (int i=0; i<waveTableSize; i++)
-        waveTable[i] = 0.0;
+    // Power of two for the FFT
+    jassert ( juce::isPowerOfTwo ( waveTableSize ) );
+    
+    int size = waveTableSize;
+    
+    setTable ( cache->getTable ( "Silence", size, [size] { return buildMipmaps ( {}, size ); } ) );
 }
 
 /// Destructo!
-Wavetable::~Wavetable()
-{
-    delete[] waveTable;
-}
+Wavetable::~Wavetable() {}
 
 
-/// Sets sampleRate and calls methodSetFrequency( )
+/// Sets the sample rate used by setIncrement( )
 void Wavetable::setSampleRate(float SR)
 {
     sampleRate = SR;
-    setFrequency();
 }
 
 
-/// Populates wavetables with wave values using their private populate functions
+/// Builds the wavetable from getHarmonic( ) of every harmonic that fits in the table
 void Wavetable::populateWavetable()
 {
-    populateWT();
+    int size = waveTableSize;
+    
+    setTable ( cache->getTable ( getWaveformName(), size, [this, size]
+    {
+        std::vector<std::complex<float>> spectrum ( size / 2 );
+        
+        for (size_t n = 1; n < spectrum.size(); n++)
+            spectrum[n] = getHarmonic ( static_cast<int>( n ) );
+        
+        return buildMipmaps ( spectrum, size );
+    } ) );
+}
+
+
+/// Builds the wavetable from sine harmonic amplitudes: amplitudes[0] is the fundamental
+void Wavetable::populateFromHarmonics(const float* amplitudes, int numHarmonics)
+{
+    std::vector<std::complex<float>> spectrum ( waveTableSize / 2 );
+    
+    for (int n = 1; n < juce::jmin ( numHarmonics + 1, static_cast<int>( spectrum.size() ) ); n++)
+        spectrum[n] = amplitudes[n - 1];
+    
+    setTable ( new WavetableData ( buildMipmaps ( spectrum, waveTableSize ) ) );
 }
 
 
 /// Main Playback of wavetable
 float Wavetable::process()
 {
-    float wtOut = lagrangeInterpolation();
+    float wtOut = lagrangeInterpolation ( lowerLevel );
     
-    readHeadPos += increment;
+    if (levelFade > 0.0f)
+        wtOut += levelFade * ( lagrangeInterpolation ( upperLevel ) - wtOut );
     
-    if (readHeadPos >= waveTableSize)
-        readHeadPos -= waveTableSize;
+    advance();
     
     return wtOut;
 }
 
 
-/// Sets wavetable step increment based on note frequency
+/// Renders numSamples of playback into out
+void Wavetable::processBlock(float* out, int numSamples)
+{
+    // The level pair only changes in setIncrement( ), so pick the loop once per block
+    if (levelFade > 0.0f)
+    {
+        for (int sample = 0; sample < numSamples; sample++)
+        {
+            float lower = lagrangeInterpolation ( lowerLevel );
+            out[sample] = lower + levelFade * ( lagrangeInterpolation ( upperLevel ) - lower );
+            advance();
+        }
+    }
+    else
+    {
+        for (int sample = 0; sample < numSamples; sample++)
+        {
+            out[sample] = lagrangeInterpolation ( lowerLevel );
+            advance();
+        }
+    }
+}
+
+
+/// Sets wavetable step increment based on note frequency, and picks the mipmap levels for it
 void Wavetable::setIncrement(float noteFreq)
 {
-    increment = ( noteFreq * waveTableSize ) / sampleRate;
+    float maxIncrement = std::nextafter ( static_cast<float>( waveTableSize ), 0.0f );
+    
+    // advance( ) wraps once and the 4-point read can't look before index -1, so keep the step in [0, waveTableSize).
+    // Negative frequencies, or ones at or over the sample rate, have no band-limited meaning anyway
+    increment = juce::jlimit ( 0.0f, maxIncrement, ( noteFreq * waveTableSize ) / sampleRate );
+    
+    updateLevels();
 }
 
 
-/// Returns the sample value at the index given in the argument
+/// Returns the sample value at the index given in the argument, from the brightest level
 float Wavetable::getWavetableSampleValue(int index)
 {
-    return waveTable[index];
+    return table->getSamples()[index];
+}
+
+
+/// Complex amplitude of a harmonic (1 = fundamental). The sine is just the fundamental
+std::complex<float> Wavetable::getHarmonic(int harmonicNumber) const
+{
+    return harmonicNumber == 1 ? 1.0f : 0.0f;
+}
+
+
+/// Name the waveform is cached under
+juce::String Wavetable::getWaveformName() const
+{
+    return "Sine";
 }
 
 
 /// Returns maximum amplitude in wavetable argument
-float Wavetable::findMaxAmplitude(float* wt)
+float Wavetable::findMaxAmplitude(const float* wt, int size)
 {
     float currentMax = 0.0f;
     
-    for (int i=0; i<waveTableSize; i++)
+    for (int i=0; i<size; i++)
     {
         if ( fabsf(wt[i]) > currentMax )
             currentMax = fabsf(wt[i]);
@@ -93,162 +161,109 @@ float Wavetable::findMaxAmplitude(float* wt)
 
 
 /// Normalizes wavetable between -1.0f and 1.0f
-void Wavetable::normalizeWaveTable()
+void Wavetable::normalizeWaveTable(float* wt, int size)
 {
-    float maxAmp = findMaxAmplitude ( waveTable );
+    float maxAmp = findMaxAmplitude ( wt, size );
     
-    for (int i=0; i<waveTableSize; i++)
-        waveTable[i] /= maxAmp;
-}
-
-
-/// Sets frequency so one cycle is waveTableSize long at sampleRate
-void Wavetable::setFrequency()
-{
-    frequency = sampleRate / waveTableSize;
-}
-
-
-/// Sets sampleRate and frequency for the sinOsc
-void Wavetable::oscSetup()
-{
-    sinOsc.setSampleRate ( sampleRate );
-    sinOsc.setFrequency  ( frequency );
+    if (maxAmp <= 0.0f)
+        return;
+    
+    for (int i=0; i<size; i++)
+        wt[i] /= maxAmp;
 }
 
 
-/// populates wavetable with values for a sine wave cycle
-void Wavetable::populateWT()
+/// Returns the inverse FFT of a spectrum (spectrum[n] = harmonic n, index 0 unused), normalized
+std::vector<float> Wavetable::buildFromSpectrum(const std::vector<std::complex<float>>& spectrum, int size)
 {
-    oscSetup();
+    // size is a power of two
+    juce::dsp::FFT fft ( juce::roundToInt ( std::log2 ( size ) ) );
+    
+    // Interleaved re/im bins 0 to size/2, room for the size real outputs
+    std::vector<float> fftData ( static_cast<size_t>( size ) * 2, 0.0f );
     
-    for (int i=0; i<waveTableSize; i++)
+    // a * sin(n * theta + p) is bin n = -i * a * e^(ip); the overall scale goes in the normalize
+    for (size_t n = 1; n < spectrum.size(); n++)
     {
-        waveTable[i] = sinOsc.process();
+        fftData[n * 2]     =  spectrum[n].imag();
+        fftData[n * 2 + 1] = -spectrum[n].real();
     }
     
+    fft.performRealOnlyInverseTransform ( fftData.data() );
+    
+    fftData.resize ( static_cast<size_t>( size ) );
+    normalizeWaveTable ( fftData.data(), size );
+    
+    return fftData;
 }
 
 
-/// Returns interpolated wavetable sample values
-float Wavetable::lagrangeInterpolation()
+/// Builds every mipmap level of a spectrum: level k keeps harmonics up to size / 2^(k + 1)
+std::vector<std::vector<float>> Wavetable::buildMipmaps(const std::vector<std::complex<float>>& spectrum, int size)
 {
-    float frac = readHeadPos - floor(readHeadPos);  // Position between indexes
-    float sum  = 0.0f;                              // initialize sum
+    std::vector<std::vector<float>> levels;
     
-    for (int i = -2; i < 2; i++)
+    // Down to the level holding just the fundamental
+    for (int maxHarmonic = size / 2; maxHarmonic >= 1; maxHarmonic /= 2)
     {
-        int index = floor(readHeadPos + (i + 1));   // index after readHeadPos in time
+        std::vector<std::complex<float>> levelSpectrum ( static_cast<size_t>( size / 2 ) );
         
-        index %= waveTableSize;                     // wrap index
+        for (size_t n = 1; n < juce::jmin ( spectrum.size(), levelSpectrum.size(), static_cast<size_t>( maxHarmonic ) + 1 ); n++)
+            levelSpectrum[n] = spectrum[n];
         
-        if (index < 0.0f)
-        {
-            index += waveTableSize;
-        }
-        
-        float outVal      = waveTable[index];       // value at wt[index] to outVal
-        float denominator = 1.0f;                   // initialize denominator
-        
-        // interpolate algorithm
-        for (int j = -2; j < 2; j++)
-        {
-            if (j != i)                             // denominator can't be 0
-            {
-                outVal      *= (frac - j);
-                denominator *= (i - j);
-            }
-        }
-        
-        sum += outVal / denominator;
+        levels.push_back ( buildFromSpectrum ( levelSpectrum, size ) );
     }
     
-    return sum;
+    return levels;
 }
 
 
-
-
-//
-//=== SawWavetable Class ================================================
-//
-
-// CHILD Class of Wavetable for band limited Sawtooth
-
-/// Creates Sawtooth Wavetable using a number of amplitude adjusted sine waves at the harmonics
-SawWavetable::SawWavetable() :
-    numSawHarmonics(57)         // Fundamental + 56 partials  -- Adjust this number to mod saw timbre
-{}
-
-SawWavetable::~SawWavetable()
-{
-    for (int i=0; i<numSawHarmonics; i++)
-        sawHarmonics.remove(i);
-}
-
-/// Populates wavetables with wave values using their private populate functions
-void SawWavetable::populateWavetable()
+/// Swaps in a new table
+void Wavetable::setTable(WavetableData::Ptr newTable)
 {
-    populateSawWT();
+    table = std::move ( newTable );
+    
+    updateLevels();
 }
 
 
-/// Adds instances of SinOsc into sawHarmonics OwnedArray
-void SawWavetable::createHarmonics()
+/// Points the playback at the mipmap levels for the current increment
+void Wavetable::updateLevels()
 {
-    for (int i=0; i<numSawHarmonics; i++)
-        sawHarmonics.add ( new SinOsc() );
+    // Level k is clean for increments below 2^k: log2(increment) + 1 puts the lower level
+    // one octave clear of Nyquist, fading towards the next (darker) one
+    int   lastLevel = table->getNumLevels() - 1;
+    float levelPos  = juce::jlimit ( 0.0f, static_cast<float>( lastLevel ), std::log2 ( juce::jmax ( increment, 1.0e-6f ) ) + 1.0f );
+    int   level     = juce::jmin ( static_cast<int>( levelPos ), juce::jmax ( 0, lastLevel - 1 ) );
+    
+    lowerLevel = table->getSamples ( level );
+    upperLevel = table->getSamples ( juce::jmin ( level + 1, lastLevel ) );
+    levelFade  = juce::jlimit ( 0.0f, 1.0f, levelPos - level );
 }
 
 
-/// Sets sample rate for each SineOsc in saw harmonics
-void SawWavetable::setSawSampleRates()
-{
-    for (int i=0; i<numSawHarmonics; i++)
-        sawHarmonics[i]->setSampleRate ( sampleRate );
-}
 
 
-/// Sets frequency for each harmonic in the saw series
-void SawWavetable::setSawFrequencies()
-{
-    float harmonicFreq;
-    
-    for (int i=0; i<numSawHarmonics; i++)
-    {
-        if (i == 0)                             // Fundamental 1/1 ratio
-            harmonicFreq = frequency;
-        else                                    // partials up the harmonic series ratios
-            harmonicFreq *= ( (i + 1.0f) / i );
+//
+//=== SawWavetable Class ================================================
+//
 
-        sawHarmonics[i]->setFrequency ( harmonicFreq );
-    }
-}
+// CHILD Class of Wavetable for band limited Sawtooth
 
+SawWavetable::SawWavetable() :
+    numSawHarmonics(512)        // Every harmonic that fits -- Adjust this number to mod saw timbre
+{}
 
-/// Runs process( ) function on each SinOsc and scales to the amplitude of that partial
-void SawWavetable::sumHarmonics()
-{
-    for (int i=0; i<waveTableSize; i++)
-    {
-        for (int j=0; j<numSawHarmonics; j++)
-        {
-            float harmonicAmplitude = 1.0f / ( j + 1.0f );  // Amplitude of harmonic is 1/n where n is the harmonic number
-            
-            waveTable[i] += sawHarmonics[j]-> process() * harmonicAmplitude;
-        }
-    }
-}
+SawWavetable::~SawWavetable() {}
 
 
-/// Populates wavetable with values for band limited saw wave
-void SawWavetable::populateSawWT()
+/// 1/n for every harmonic up to numSawHarmonics
+std::complex<float> SawWavetable::getHarmonic(int harmonicNumber) const
 {
-    createHarmonics();
-    setSawSampleRates();
-    setSawFrequencies();
-    sumHarmonics();
-    normalizeWaveTable();
+    if (harmonicNumber < 1 || harmonicNumber > numSawHarmonics)
+        return 0.0f;
+    
+    return 1.0f / harmonicNumber;   // Amplitude of harmonic is 1/n where n is the harmonic number
 }
 
 
@@ -258,87 +273,22 @@ void SawWavetable::populateSawWT()
 //=== SquareWavetable Class ================================================
 //
 
-/// Creates Square Wavetable using a number of amplitude adjusted sine waves at the odd harmonics
+/// Creates Square Wavetable from the 1/n amplitudes of the odd harmonics
 SquareWavetable::SquareWavetable() :
-    numSquareHarmonics(57)              // Fundamental + 56 partials -- Adjust this number to mod square timbre
+    numSquareHarmonics(256)             // Every odd harmonic that fits -- Adjust this number to mod square timbre
 {}
 
-SquareWavetable::~SquareWavetable()
-{
-    for (int i=0; i<numSquareHarmonics; i++)
-        squareHarmonics.remove ( i );
-}
-
-/// Populates wavetables with wave values using their private populate functions
-void SquareWavetable::populateWavetable()
-{
-    populateSquareWT();
-}
-
-
-/// Adds instances of SinOsc into squareHarmonics OwnedArray
-void SquareWavetable::createHarmonics()
-{
-    for (int i=0; i<numSquareHarmonics; i++)
-        squareHarmonics.add( new SinOsc() );
-}
-
-
-/// Sets sample rate for each SineOsc in saw harmonics
-void SquareWavetable::setSquareSampleRates()
-{
-    for (int i=0; i<numSquareHarmonics; i++)
-        squareHarmonics[i]->setSampleRate ( sampleRate );
-}
+SquareWavetable::~SquareWavetable() {}
 
 
-/** Sets frequency for each harmonicin the Square series by finding all the harmonics from
-the fundamental to double the number of harmonics, then using the odd harmonics to set the
-frequency for each sine instance
-*/
-void SquareWavetable::setSquareFrequencies()
+/// 1/n for the first numSquareHarmonics odd harmonics
+std::complex<float> SquareWavetable::getHarmonic(int harmonicNumber) const
 {
-    int    twiceOddHarmonics = numSquareHarmonics * 2;
-    float* harmonicFreq      = new float[twiceOddHarmonics];
-    
-    for (int i=0; i<twiceOddHarmonics; i++)
-    {
-        if (i == 0)     // Fundamental 1/1
-            harmonicFreq[i] = frequency;
-        else
-            harmonicFreq[i] = harmonicFreq[i-1] * ( (i + 1.0f) / i );   // Harmonic series ratios
-        
-        if (i % 2 == 0) // Use the odd harmonics (at the even indexes) to set the frequencies
-            squareHarmonics[i / 2]->setFrequency ( harmonicFreq[i] );
-    }
+    // Odd harmonics only: the (n + 1) / 2 th odd harmonic
+    if (harmonicNumber < 1 || harmonicNumber % 2 == 0 || ( harmonicNumber + 1 ) / 2 > numSquareHarmonics)
+        return 0.0f;
     
-    delete[] harmonicFreq;
-}
-
-
-/// Runs process( ) function on each SinOsc and scales to the amplitude of that partial
-void SquareWavetable::sumHarmonics()
-{
-    for (int i=0; i<waveTableSize; i++)
-    {
-        for (int j=0; j<numSquareHarmonics; j++)
-        {
-            float harmonicAmplitude = 1.0f / ( j * 2.0f + 1.0f );    // Amplitude of harmonic is 1/n where n is the harmonic number
-            
-            waveTable[i] += squareHarmonics[j]-> process() * harmonicAmplitude;
-        }
-    }
-}
-
-
-/// Populates wavetable with values for band limited square wave
-void SquareWavetable::populateSquareWT()
-{
-    createHarmonics();
-    setSquareSampleRates();
-    setSquareFrequencies();
-    sumHarmonics();
-    normalizeWaveTable();
+    return 1.0f / harmonicNumber;
 }
 
 
@@ -348,27 +298,20 @@ void SquareWavetable::populateSquareWT()
 //=== SpikeWavetable Class ================================================
 //
 
-/// Highpasses wavetable
-void SpikeWavetable::highPassSpike()
+/// Square harmonics through a 2nd order highpass at the 10th harmonic (Q = 2)
+std::complex<float> SpikeWavetable::getHarmonic(int harmonicNumber) const
 {
-    cutoffFreq = frequency * 10.0f;
+    auto squareHarmonic = SquareWavetable::getHarmonic ( harmonicNumber );
     
-    highPass.reset();
-    highPass.setCoefficients( juce::IIRCoefficients::makeHighPass ( sampleRate, cutoffFreq, 2.0f ) );
+    if (squareHarmonic == 0.0f)
+        return squareHarmonic;
     
-    for (int i=0; i<waveTableSize; i++)
-        waveTable[i] = highPass.processSingleSampleRaw ( waveTable[i] );
-}
-
-
-/// Populates wavetable with Spike derived from band limited square wavetable
-void SpikeWavetable::populateSquareWT()
-{
-    createHarmonics();
-    setSquareSampleRates();
-    setSquareFrequencies();
-    sumHarmonics();
-    highPassSpike();
-    normalizeWaveTable();
+    // Analog highpass response H(s) = s^2 / (s^2 + s/Q + 1), s = j * n / 10. Applied in the
+    // spectrum it filters the periodic wave directly, with no start-up transient in the table
+    const float cutoffHarmonic = 10.0f;
+    const float Q              = 2.0f;
+    
+    std::complex<float> s ( 0.0f, harmonicNumber / cutoffHarmonic );
+    
+    return squareHarmonic * ( s * s ) / ( s * s + s / Q + 1.0f );
 }
-
@@ -19,7 +19,10 @@
 */
 
 #pragma once
-#include "Oscillators.h"
+
+#include <complex>
+#include <JuceHeader.h>
+#include "WavetableCache.h"
 
 
 //
@@ -27,7 +30,23 @@
 //
 
 
-/// Creates wavetable of a single Sine Wave cycle
+/**
+ Creates wavetable of a single Sine Wave cycle.
+
+ Every wavetable is described by its harmonic spectrum (getHarmonic( )) and
+ built from it with one inverse real FFT, so a table of any spectrum costs
+ the same to build. Tables are immutable and come from the process-wide
+ WavetableCache, so instances of the same waveform share one table and
+ re-populating an already built waveform costs nothing.
+
+ Each table is mipmapped per octave: level k only keeps the harmonics that stay
+ under Nyquist for increments below 2^k. setIncrement( ) (control rate) picks
+ the pair of levels for the current pitch and the crossfade between them, so
+ playback is alias-free at any pitch and keeps every harmonic at low ones.
+
+ Reads are cubic Lagrange in Horner form on power-of-two tables with guard
+ points, so they need no wrapping.
+ */
 class Wavetable
 {
 public:
@@ -37,101 +56,137 @@ public:
     /// Destructo!
     virtual ~Wavetable();
     
-    /// Sets sampleRate and calls methodSetFrequency( )
+    /// Sets the sample rate used by setIncrement( )
     void setSampleRate(float SR);
     
-    /// Populates wavetables with wave values using their private populate functions
-    virtual void populateWavetable();
+    /// Builds the wavetable from getHarmonic( ) of every harmonic that fits in the table
+    void populateWavetable();
+    
+    /// Builds an uncached wavetable from sine harmonic amplitudes: amplitudes[0] is the fundamental
+    void populateFromHarmonics(const float* amplitudes, int numHarmonics);
     
     /// Main Playback of wavetable
     float process();
     
-    /// Sets wavetable step increment based on note frequency
+    /// Renders numSamples of playback into out
+    void processBlock(float* out, int numSamples);
+    
+    /// Sets wavetable step increment based on note frequency, and picks the mipmap levels for it
     void setIncrement(float noteFreq);
     
-    /// Returns the sample value at the index given in the argument
+    /// Returns the sample value at the index given in the argument, from the brightest level
     float getWavetableSampleValue(int index);
 
     
 protected:
+    /**
+     Complex amplitude of a harmonic (1 = fundamental): magnitude a and phase p give
+     a * sin(n * theta + p). Returns 0 for harmonics not in the wave
+     */
+    virtual std::complex<float> getHarmonic(int harmonicNumber) const;
+    
+    /// Name the waveform is cached under. Every class with its own getHarmonic( ) needs its own name
+    virtual juce::String getWaveformName() const;
+    
     /// Returns maximum amplitude in wavetable argument
-    float findMaxAmplitude(float* wt);
+    static float findMaxAmplitude(const float* wt, int size);
     
     /// Normalizes wavetable between -1.0f and 1.0f
-    void normalizeWaveTable();
+    static void normalizeWaveTable(float* wt, int size);
     
     // Wavetable Parameters
     int   waveTableSize;
     float sampleRate;
-    float frequency;
     
-    // Create buffer for wavetables
-    float* waveTable = new float[waveTableSize];
     
-    // Instance of oscillators
-    SinOsc sinOsc;
+private:
+    /// Returns the inverse FFT of a spectrum (spectrum[n] = harmonic n, index 0 unused), normalized
+    static std::vector<float> buildFromSpectrum(const std::vector<std::complex<float>>& spectrum, int size);
     
+    /// Builds every mipmap level of a spectrum: level k keeps harmonics up to size / 2^(k + 1)
+    static std::vector<std::vector<float>> buildMipmaps(const std::vector<std::complex<float>>& spectrum, int size);
     
-private:
-    /// Sets frequency so one cycle is waveTableSize long at sampleRate
-    void setFrequency();
+    /// Swaps in a new table
+    void setTable(WavetableData::Ptr newTable);
     
-    /// Sets sampleRate and frequency for the sinOsc
-    virtual void oscSetup();
+    /// Points the playback at the mipmap levels for the current increment
+    void updateLevels();
     
-    /// populates wavetable with values for a sine wave cycle
-    virtual void populateWT();
+    /// 4-point, 3rd order Lagrange read of wt at readHeadPos
+    inline float lagrangeInterpolation(const float* wt) const;
     
-    /// Returns interpolated wavetable sample values
-    float lagrangeInterpolation();
+    /// Moves the read head on one increment
+    inline void advance();
     
     // Playback parameters
     float readHeadPos;
     float increment;    // Increment controls speed of readHeadPos, controlling playback frequency
     
+    // Shared table, and the two mipmap levels playing with the crossfade between them
+    juce::SharedResourcePointer<WavetableCache> cache;
+    WavetableData::Ptr                          table;
+    const float*                                lowerLevel;
+    const float*                                upperLevel;
+    float                                       levelFade;
+    
 };
 
 
+inline float Wavetable::lagrangeInterpolation(const float* wt) const
+{
+    int   index = static_cast<int>( readHeadPos );     // readHeadPos is never negative
+    float frac  = readHeadPos - index;
+    
+    // The guard points make index - 1 and index + 2 valid everywhere
+    float ym1 = wt[index - 1];
+    float y0  = wt[index    ];
+    float y1  = wt[index + 1];
+    float y2  = wt[index + 2];
+    
+    float c1 = y1 - ( 1.0f / 3.0f ) * ym1 - 0.5f * y0 - ( 1.0f / 6.0f ) * y2;
+    float c2 = 0.5f * ( ym1 + y1 ) - y0;
+    float c3 = ( 1.0f / 6.0f ) * ( y2 - ym1 ) + 0.5f * ( y0 - y1 );
+    
+    return ( ( c3 * frac + c2 ) * frac + c1 ) * frac + y0;
+}
+
+
+inline void Wavetable::advance()
+{
+    // setIncrement( ) keeps increment in [0, waveTableSize), so this runs once; the loop only covers float rounding up to the size
+    readHeadPos += increment;
+    
+    while (readHeadPos >= waveTableSize)
+        readHeadPos -= waveTableSize;
+}
+
+
 //========================================================================
 
 
 // CHILD Class of Wavetable for band limited Sawtooth
+/// Creates Sawtooth Wavetable from the 1/n amplitudes of the harmonic series
 class SawWavetable : public Wavetable
 {
 public:
-    /// Creates Sawtooth Wavetable using a number of amplitude adjusted sine waves at the harmonics
     SawWavetable();
     ~SawWavetable();
     
-    /// Populates wavetables with wave values using their private populate functions
-    void populateWavetable() override;
-    
-private:
-    /// Adds instances of SinOsc into sawHarmonics OwnedArray
-    void createHarmonics();
-    
-    /// Sets sample rate for each SineOsc in saw harmonics
-    void setSawSampleRates();
-    
-    /// Sets frequency for each harmonic in the saw series
-    void setSawFrequencies();
-    
-    /// Runs process( ) function on each SinOsc and scales to the amplitude of that partial
-    void sumHarmonics();
+protected:
+    /// 1/n for every harmonic up to numSawHarmonics
+    std::complex<float> getHarmonic(int harmonicNumber) const override;
     
-    /// Populates wavetable with values for band limited saw wave
-    void populateSawWT();
+    juce::String getWaveformName() const override { return "Saw"; }
     
-    // Instance of oscillators
-    juce::OwnedArray<SinOsc> sawHarmonics;
-    int                      numSawHarmonics; // Fundamental + 56 partials  -- Adjust this number to mod saw timbre
+private:
+    int numSawHarmonics; // Every harmonic that fits -- Adjust this number to mod saw timbre
 };
 
 
 //========================================================================
 
 //Child class of Wavetable for square wave
-/// Creates Square Wavetable using a number of amplitude adjusted sine waves at the odd harmonics
+/// Creates Square Wavetable from the 1/n amplitudes of the odd harmonics
 class SquareWavetable : public Wavetable
 {
 public:
@@ -139,32 +194,14 @@ public:
     SquareWavetable();
     ~SquareWavetable();
     
-    /// Populates wavetables with wave values using their private populate functions
-    void populateWavetable() override;
-    
 protected:
-    /// Adds instances of SinOsc into squareHarmonics OwnedArray
-    void createHarmonics();
-    
-    /// Sets sample rate for each SineOsc in square harmonics
-    void setSquareSampleRates();
-    
-    /** Sets frequency for each harmonicin the Square series by finding all the harmonics from
-     the fundamental to double the number of harmonics, then using the odd harmonics to set the
-     frequency for each sine instance
-     */
-    void setSquareFrequencies();
+    /// 1/n for the first numSquareHarmonics odd harmonics
+    std::complex<float> getHarmonic(int harmonicNumber) const override;
     
-    /// Runs process( ) function on each SinOsc and scales to the amplitude of that partial
-    void sumHarmonics();
+    juce::String getWaveformName() const override { return "Square"; }
     
 private:
-    /// Populates wavetable with values for band limited square wave
-    virtual void populateSquareWT();
-    
-    // Instance of oscillators
-    juce::OwnedArray<SinOsc> squareHarmonics;
-    int                      numSquareHarmonics; // Fundamental + 56 partials -- Adjust this number to mod square timbre
+    int numSquareHarmonics; // Every odd harmonic that fits -- Adjust this number to mod square timbre
     
 };
 
@@ -176,14 +213,9 @@ private:
 /// Creates a Spike wavetable by highpassing a square wavetable
 class SpikeWavetable : public SquareWavetable
 {
-private:
-    /// Highpasses wavetable
-    void highPassSpike();
-    
-    /// Populates wavetable with Spike derived from band limited square wavetable
-    void populateSquareWT() override;
+protected:
+    /// Square harmonics through a 2nd order highpass at the 10th harmonic (Q = 2)
+    std::complex<float> getHarmonic(int harmonicNumber) const override;
     
-    // Highpass members
-    juce::IIRFilter highPass;
-    float           cutoffFreq;
+    juce::String getWaveformName() const override { return "Spike"; }
 };
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    WavetableCache.cpp
+    Created: 17 Oct 2026 5:12:36pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#include "WavetableCache.h"
+
+WavetableCache::WavetableCache() {}
+
+WavetableCache::~WavetableCache() {}
+
+
+/// Returns the cached table for waveform/size, calling build( ) to make it if it isn't cached
+WavetableData::Ptr WavetableCache::getTable(const juce::String& waveform, int tableSize, const Builder& build)
+{
+    const juce::ScopedLock sl ( lock );
+    
+    removeUnusedTables();
+    
+    auto key = std::make_pair ( waveform, tableSize );
+    auto it  = tables.find ( key );
+    
+    if (it != tables.end())
+        return it->second;
+    
+    WavetableData::Ptr table = new WavetableData ( build() );
+    tables[key] = table;
+    
+    return table;
+}
+
+
+/// Number of tables currently cached
+int WavetableCache::getNumTables() const
+{
+    const juce::ScopedLock sl ( lock );
+    
+    return static_cast<int>( tables.size() );
+}
+
+
+/// Drops tables only the cache still holds
+void WavetableCache::removeUnusedTables()
+{
+    for (auto it = tables.begin(); it != tables.end();)
+    {
+        if (it->second->getReferenceCount() == 1)
+            it = tables.erase ( it );
+        else
+            ++it;
+    }
+}
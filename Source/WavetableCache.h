@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    WavetableCache.h
+    Created: 17 Oct 2026 5:12:36pm
+    Author:  Robert Fullum
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ An immutable, reference counted wavetable. Shared between every Wavetable playing it.
+ Holds one or more mipmap levels of the same size, level 0 being the brightest.
+ 
+ Every level is stored with guard points: one wrapped sample before index 0 and
+ two after the end, so a 4-point read at any index in [0, size) never has to wrap
+ */
+class WavetableData : public juce::ReferenceCountedObject
+{
+public:
+    // Non-const pointee: ReferenceCountedObjectPtr needs to touch the count. The samples are only reachable through const accessors
+    using Ptr = juce::ReferenceCountedObjectPtr<WavetableData>;
+    
+    static constexpr int guardBefore = 1;
+    static constexpr int guardAfter  = 2;
+    
+    explicit WavetableData(std::vector<std::vector<float>> tableLevels) :
+        size   ( static_cast<int>( tableLevels.front().size() ) ),
+        levels ( addGuardPoints ( std::move ( tableLevels ) ) )
+    {}
+    
+    /// Sample 0 of a level. Indices -1 to getSize( ) + 1 are valid
+    const float* getSamples(int level = 0) const { return levels[static_cast<size_t>( level )].data() + guardBefore; }
+    int          getNumLevels()            const { return static_cast<int>( levels.size() ); }
+    int          getSize()                 const { return size; }
+    
+private:
+    static std::vector<std::vector<float>> addGuardPoints(std::vector<std::vector<float>> tableLevels)
+    {
+        for (auto& level : tableLevels)
+        {
+            float last = level.back();
+            
+            level.insert    ( level.begin(), last );
+            level.push_back ( level[guardBefore]     );
+            level.push_back ( level[guardBefore + 1] );
+        }
+        
+        return tableLevels;
+    }
+    
+    const int                             size;
+    const std::vector<std::vector<float>> levels;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableData)
+};
+
+
+/**
+ Process-wide cache of built wavetables, keyed by waveform name and table size.
+ 
+ Hold it through a juce::SharedResourcePointer<WavetableCache>. A waveform is only
+ built the first time it's asked for; after that every instance, and every later
+ prepareToPlay( ), gets the same table. Tables nobody holds any more are dropped
+ the next time the cache is asked for one.
+ */
+class WavetableCache
+{
+public:
+    using Builder = std::function<std::vector<std::vector<float>>()>;
+    
+    WavetableCache();
+    ~WavetableCache();
+    
+    /// Returns the cached table for waveform/size, calling build( ) to make it if it isn't cached
+    WavetableData::Ptr getTable(const juce::String& waveform, int tableSize, const Builder& build);
+    
+    /// Number of tables currently cached
+    int getNumTables() const;
+    
+private:
+    /// Drops tables only the cache still holds
+    void removeUnusedTables();
+    
+    std::map<std::pair<juce::String, int>, WavetableData::Ptr> tables;
+    juce::CriticalSection                                      lock;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableCache)
+};